@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+/**
+ * @file pool_reopen.cpp
+ * @brief Benchmark of opening and closing an editor of several thousand rows, with and without the ParamWidgetPool.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ *
+ * Each pass builds a ParamsEditor of Rows rows (double, int, string and bool
+ * parameters, a quarter each), shows it, lets it lay out and destroys it. The
+ * passes run first with ParamWidgetPool::setCapacity(0), as before the pool, then
+ * with a capacity covering the editor, and the median open and close times of
+ * both are printed. The pool is trimmed at the end, as an application does when
+ * it closes its last editor.
+ *
+ * Built with -DPARAMEDITOR_BUILD_CHECKS=ON and run by ctest; exits with 1 if the
+ * pooled widgets are not reused or not released by trim().
+ */
+
+#include "parameditor.h"
+#include <QtWidgets>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+const int Rows = 4000;  ///< Rows of the benchmarked editor.
+const int Passes = 7;   ///< Open and close passes per configuration.
+
+/// Referenced variables of the benchmarked rows.
+struct Values {
+    double  d[Rows / 4];
+    int     i[Rows / 4];
+    QString s[Rows / 4];
+    bool    b[Rows / 4];
+};
+
+/// Median open and close times of a configuration, in milliseconds.
+struct Timing {
+    double open = 0.0;
+    double close = 0.0;
+};
+
+double median(QVector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/**
+ * @brief Open and close the editor Passes times, after one warm-up pass.
+ */
+Timing run(Values& values) {
+    QVector<double> open, close;
+    for (int pass = 0; pass <= Passes; ++pass) {
+        QElapsedTimer timer;
+        timer.start();
+        ParamsEditor* editor = new ParamsEditor;
+        const int tab = editor->addTab("Rows");
+        for (int r = 0; r < Rows / 4; ++r) {
+            const QString n = QString::number(r);
+            editor->addParam(tab, new DoubleParam("Double " + n, &values.d[r], 0.0, 100.0, 0.01, ""));
+            editor->addParam(tab, new IntParam("Int " + n, &values.i[r], 0, 100, 1, ""));
+            editor->addParam(tab, new StringParam("String " + n, &values.s[r], "", Qt::ImhNone, ""));
+            editor->addParam(tab, new BoolParam("Bool " + n, &values.b[r], false, ""));
+        }
+        editor->show();
+        QCoreApplication::processEvents();
+        const double opened = timer.nsecsElapsed() / 1e6;
+        timer.restart();
+        delete editor;
+        QCoreApplication::processEvents();
+        const double closed = timer.nsecsElapsed() / 1e6;
+        if (pass == 0) continue;
+        open.append(opened);
+        close.append(closed);
+    }
+    Timing t;
+    t.open = median(open);
+    t.close = median(close);
+    return t;
+}
+
+bool check(bool ok, const char* what) {
+    std::printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QScopedPointer<Values> values(new Values());
+    bool ok = true;
+
+    ParamWidgetPool::setCapacity(0);
+    const Timing unpooled = run(*values);
+    ok &= check(ParamWidgetPool::freeCount() == 0, "nothing kept without capacity");
+
+    ParamWidgetPool::setCapacity(Rows);
+    const Timing pooled = run(*values);
+    ok &= check(ParamWidgetPool::freeCount() >= Rows, "closed editor's widgets kept for the next one");
+
+    ParamWidgetPool::trim();
+    ok &= check(ParamWidgetPool::freeCount() == 0, "trim() releases the pool");
+
+    std::printf("%d rows, median of %d passes\n", Rows, Passes);
+    std::printf("without pool: open %.1f ms, close %.1f ms\n", unpooled.open, unpooled.close);
+    std::printf("with pool:    open %.1f ms, close %.1f ms\n", pooled.open, pooled.close);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file tree_roundtrip.cpp
+ * @brief Save and load check of a VariantTreeParam holding a value of about 50 MB.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ *
+ * With the default load limits:
+ * - a settings-like value of about 50 MB must save and load back unchanged;
+ * - a value that cannot be saved within the limits must make saveToFile() fail
+ *   and leave the previous file untouched.
+ *
+ * Built with -DPARAMEDITOR_BUILD_CHECKS=ON and run by ctest; exits with 1 on failure.
+ */
+
+#include "parameditor.h"
+#include <QtWidgets>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+const qint64 TargetBytes = 50 * 1024 * 1024; ///< Size of the checked value, as written by QDataStream.
+
+/**
+ * @brief Size of a value as written by QDataStream, close to its size in memory.
+ */
+qint64 streamSize(const QVariant& v) {
+    QByteArray raw;
+    QDataStream out(&raw, QIODevice::WriteOnly);
+    out << v;
+    return raw.size();
+}
+
+/**
+ * @brief Build a list of tool records, the kind of value read from JSON settings.
+ */
+QVariant settingsTree(qint64 bytes) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> offset(-50.0, 50.0);
+    QVariantList tools;
+    qint64 size = 0;
+    for (int i = 0; size < bytes; ++i) {
+        QVariantMap limits;
+        limits.insert("min", offset(rng));
+        limits.insert("max", offset(rng) + 100.0);
+        QVariantMap tool;
+        tool.insert("id", i);
+        tool.insert("name", QString("Tool %1").arg(i));
+        tool.insert("enabled", i % 3 != 0);
+        tool.insert("offset", offset(rng));
+        tool.insert("tags", QStringList{ "cut", QString("slot %1").arg(i % 64) });
+        tool.insert("limits", limits);
+        size += streamSize(tool);
+        tools.append(tool);
+    }
+    QVariantMap root;
+    root.insert("version", 3);
+    root.insert("tools", tools);
+    return root;
+}
+
+/**
+ * @brief Build a value that does not compress, too large for the default file size limit.
+ */
+QVariant noiseTree(qint64 bytes) {
+    std::mt19937 rng(11);
+    QByteArray noise(int(bytes), Qt::Uninitialized);
+    for (char& c : noise) c = char(rng());
+    QVariantMap root;
+    root.insert("blob", noise);
+    return root;
+}
+
+bool check(bool ok, const char* what) {
+    std::printf("%s: %s\n", ok ? "ok" : "FAILED", what);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    QTemporaryDir dir;
+    const QString path = dir.filePath("tree.xml");
+
+    QVariant tree;
+    ParamsEditor editor;
+    VariantTreeParam* param = new VariantTreeParam("Tree", &tree, QVariant(), "");
+    editor.addParam(editor.addTab("Check"), param);
+    bool ok = true;
+
+    const QVariant settings = settingsTree(TargetBytes);
+    param->setValue(settings);
+    ok &= check(editor.saveToFile(path), "save a 50 MB settings tree");
+    const qint64 savedSize = QFileInfo(path).size();
+    param->setValue(QVariant());
+    ok &= check(editor.loadFromFile(path), "load it back within the default limits");
+    ok &= check(param->value() == settings, "loaded tree equals the saved one");
+
+    param->setValue(noiseTree(TargetBytes));
+    ok &= check(!editor.saveToFile(path) && !editor.saveError().isEmpty(), "refuse to save a tree beyond the file size limit");
+    ok &= check(QFileInfo(path).size() == savedSize && editor.loadFromFile(path), "previous file kept and still loadable");
+
+    std::printf("settings tree: %lld bytes saved as %lld\n", streamSize(settings), savedSize);
+    return ok ? 0 : 1;
+}
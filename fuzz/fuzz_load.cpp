@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file fuzz_load.cpp
+ * @brief libFuzzer harness for ParamsEditor::loadFromData() and the ParamBase::load() implementations.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ *
+ * Build with -DPARAMEDITOR_BUILD_FUZZ=ON using clang, then run e.g.
+ * @code
+ * QT_QPA_PLATFORM=offscreen ./paramfuzz -max_len=65536 -max_total_time=600 corpus/ ../fuzz/corpus/
+ * @endcode
+ * fuzz/corpus holds seeds for known hazards, such as containers nested two
+ * hundred thousand levels deep inside a plain value of a variant tree, or a
+ * run of self-closing elements whose name two parameters share, or NaN and
+ * infinite floats in a LUT and a curve. The fuzz builds also run
+ * UndefinedBehaviorSanitizer, which aborts on the first report.
+ * Every input slower than the ones before it is reported on stderr together
+ * with its size, so the log ends with the worst-case load time found; set
+ * PARAMFUZZ_WORST to a file name to keep a copy of that input. Built with
+ * PARAMFUZZ_STANDALONE defined, the program instead loads the files given on
+ * the command line (a corpus or a crash reproducer) and reports the slowest.
+ */
+
+#include "parameditor.h"
+#include <QtWidgets>
+#include <cstdio>
+
+namespace {
+
+/**
+ * @struct Target
+ * @brief Editor with one parameter of each type, built once per process.
+ */
+struct Target {
+    double              d = 1.0;
+    double              twin = 1.0;
+    int                 i = 1;
+    float               f = 1.0f;
+    double              gain = 0.5;
+    QString             text, file, dir, image, password;
+    QStringList         options{ "a", "b", "c" };
+    int                 option = 0;
+    QColor              color = Qt::red;
+    bool                flag = false;
+    QFont               font;
+    QDateTime           dateTime;
+    QDate               date;
+    QTime               time;
+    QPair<double, double> range{ 0.0, 1.0 };
+    QStringList         list;
+    QPoint              point;
+    QSize               size;
+    QRect               rect;
+    QVariant            variant;
+    QVector<QPointF>    curve{ QPointF(0, 0), QPointF(1, 1) };
+    QVector<float>      lut;
+    QVector<double>     group;
+    QVector<QVariant>   records;
+    QVariant            tree;
+    ParamsEditor        editor;
+
+    Target() {
+        const int tab = editor.addTab("Fuzz");
+        editor.addParam(tab, new DoubleParam("Double", &d, -1e6, 1e6, 0.1, ""));
+        editor.addParam(tab, new IntParam("Int", &i, -1000000, 1000000, 1, ""));
+        editor.addParam(tab, new FloatParam("Float", &f, -1e6f, 1e6f, 0.1f, ""));
+        editor.addParam(tab, new SliderParam("Slider", &gain, 0.0, 1.0, 0.01, ""));
+        editor.addParam(tab, new StringParam("String", &text, "", Qt::ImhNone, ""));
+        editor.addParam(tab, new ComboParam("Combo", &options, &option, 0, ""));
+        editor.addParam(tab, new ColorParam("Color", &color, Qt::red, ""));
+        editor.addParam(tab, new FilePathParam("File", &file, "", ""));
+        editor.addParam(tab, new DirParam("Dir", &dir, "", ""));
+        editor.addParam(tab, new ImageParam("Image", &image, "", ""));
+        editor.addParam(tab, new BoolParam("Bool", &flag, false, ""));
+        editor.addParam(tab, new FontParam("Font", &font, QFont(), ""));
+        editor.addParam(tab, new PasswordParam("Password", &password, "", ""));
+        editor.addParam(tab, new DateTimeParam("DateTime", &dateTime, QDateTime(QDate(2025, 1, 1), QTime(0, 0)), ""));
+        editor.addParam(tab, new DateParam("Date", &date, QDate(2025, 1, 1), ""));
+        editor.addParam(tab, new TimeParam("Time", &time, QTime(0, 0), ""));
+        editor.addParam(tab, new RangeParam("Range", &range, 0.0, 1.0, 0.01, range, ""));
+        editor.addParam(tab, new StringListParam("List", &list, QStringList(), ""));
+        editor.addParam(tab, new PointParam("Point", &point, QPoint(), ""));
+        editor.addParam(tab, new SizeParam("Size", &size, QSize(), ""));
+        editor.addParam(tab, new RectParam("Rect", &rect, QRect(), ""));
+        editor.addParam(tab, new VariantParam("Variant", &variant, QVariant(), ""));
+        editor.addParam(tab, new CurveParam("Curve", &curve, curve, ""));
+        editor.addParam(tab, new LutParam("Lut", &lut, 64, 64, 0.0f, 1.0f, ""));
+        ParamGroupTemplate axis;
+        axis.addField("p", "P", 0.0, 100.0, 0.1, 1.0, "");
+        axis.addField("i", "I", 0.0, 100.0, 0.1, 0.0, "");
+        editor.addParam(tab, new GroupParam("Group", axis, &group));
+        editor.addParam(tab, new RecordTableParam("Records", &records, {
+            RecordColumn::boolColumn("on", "On", ""),
+            RecordColumn::intColumn("tool", "Tool", 0, 999, ""),
+            RecordColumn::doubleColumn("length", "Length", 0.0, 1000.0, 0.01, 3, ""),
+            RecordColumn::stringColumn("note", "Note", ""),
+            RecordColumn::choiceColumn("kind", "Kind", options, "") }, ""));
+        editor.addParam(tab, new VariantTreeParam("Tree", &tree, QVariant(), ""));
+        // Same name on another tab: one element must feed only the first of them
+        editor.addParam(editor.addTab("Twin"), new DoubleParam("Double", &twin, -1e6, 1e6, 0.1, ""));
+    }
+};
+
+Target& target() {
+    static int argc = 1;
+    static char name[] = "paramfuzz";
+    static char* argv[] = { name, nullptr };
+    static QApplication app(argc, argv);
+    static Target t;
+    return t;
+}
+
+qint64 worstNs = 0; ///< Slowest load so far.
+
+/**
+ * @brief Load one input and report it if it is the slowest so far.
+ * @return Load time in nanoseconds.
+ */
+qint64 timedLoad(const QByteArray& data, const char* what) {
+    Target& t = target();
+    QElapsedTimer timer;
+    timer.start();
+    t.editor.loadFromData(data);
+    const qint64 ns = timer.nsecsElapsed();
+    if (ns > worstNs) {
+        worstNs = ns;
+        std::fprintf(stderr, "paramfuzz: new worst case %.3f ms, %d bytes%s%s\n",
+            ns / 1e6, data.size(), what ? ", " : "", what ? what : "");
+        const QByteArray keep = qgetenv("PARAMFUZZ_WORST");
+        if (!keep.isEmpty()) {
+            QFile out(QString::fromLocal8Bit(keep));
+            if (out.open(QIODevice::WriteOnly)) out.write(data);
+        }
+    }
+    return ns;
+}
+
+} // namespace
+
+#ifndef PARAMFUZZ_STANDALONE
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    timedLoad(QByteArray(reinterpret_cast<const char*>(data), int(size)), nullptr);
+    return 0;
+}
+
+#else
+
+int main(int argc, char* argv[]) {
+    for (int a = 1; a < argc; ++a) {
+        QFile in(QString::fromLocal8Bit(argv[a]));
+        if (!in.open(QIODevice::ReadOnly)) {
+            std::fprintf(stderr, "paramfuzz: cannot read %s\n", argv[a]);
+            continue;
+        }
+        timedLoad(in.readAll(), argv[a]);
+    }
+    std::printf("worst-case load: %.3f ms\n", worstNs / 1e6);
+    return 0;
+}
+
+#endif
@@ -9,16 +9,21 @@ int main(int argc, char* argv[]) {
     // Example variables for parameters
     double          doubleVal = 3.1415;
     int             intVal = 42;
+    double          gainVal = 0.5;
+    double          thickness = 1.5; // mm
     QString         stringVal = "Hello World";
     QStringList     comboOptions = { "Option 1", "Option 2", "Option 3" };
     int             comboIndex = 1;
     QColor          colorVal = Qt::blue;
     QString         filePath = "C:/test.txt";
     QString         dirPath = "C:/Documents";
+    QString         imagePath = "C:/mask.png";
     bool            boolVal = true;
     QFont           fontVal = QApplication::font();
     QString         password = "secret";
     QDateTime       dateTimeVal = QDateTime::currentDateTime();
+    QVector<QPointF> gammaCurve = { QPointF(0, 0), QPointF(0.5, 0.6), QPointF(1, 1) };
+    QVector<float>  shadingLut(64 * 64, 0.5f);
     
     // Example class
     ExtendedConfig config;
@@ -28,10 +33,15 @@ int main(int argc, char* argv[]) {
     // Add tabs
     int generalTab = editor.addTab("Simple");
     int fileTab = editor.addTab("File Settings");
+    int curveTab = editor.addTab("Curves");
 
     // Add parameters to the General tab
     editor.addParam(generalTab, new DoubleParam("Pi", &doubleVal, 0.0, 10.0, 0.01, "Approximation of Pi"));
     editor.addParam(generalTab, new IntParam("Answer", &intVal, 0, 100, 1, "The answer to everything"));
+    editor.addParam(generalTab, new SliderParam("Gain", &gainVal, 0.0, 1.0, 0.01, "Output gain"));
+    DoubleParam* thicknessParam = new DoubleParam("Thickness", &thickness, 0.0, 100.0, 0.01, "Sheet thickness");
+    thicknessParam->setUnit("length");
+    editor.addParam(generalTab, thicknessParam);
     editor.addParam(generalTab, new StringParam("Message", &stringVal, "Default", Qt::ImhNone, "Test message"));
     editor.addParam(generalTab, new ComboParam("Options", &comboOptions, &comboIndex, 0, "Select an option"));
     editor.addParam(generalTab, new ColorParam("Color", &colorVal, Qt::red, "Background color"));
@@ -43,6 +53,11 @@ int main(int argc, char* argv[]) {
     // Add parameters to the File Settings tab
     editor.addParam(fileTab, new FilePathParam("Config File", &filePath, "config.ini", "Configuration file"));
     editor.addParam(fileTab, new DirParam("Data Dir", &dirPath, "data/", "Data directory"));
+    editor.addParam(fileTab, new ImageParam("Mask Image", &imagePath, "mask.png", "Calibration mask"));
+
+    // Add parameters to the Curves tab
+    editor.addParam(curveTab, new CurveParam("Gamma", &gammaCurve, gammaCurve, "Tone curve"));
+    editor.addParam(curveTab, new LutParam("Shading", &shadingLut, 64, 64, 0.0f, 1.0f, "Shading correction"));
 
     AdvancedPropertyAdapter::bindObjectToEditor(&editor, &config, "Class");
 
@@ -68,11 +83,15 @@ int main(int argc, char* argv[]) {
         qDebug() << "=== Modified Values ===";
         qDebug() << "Pi:" << doubleVal;
         qDebug() << "Answer:" << intVal;
+        qDebug() << "Gain:" << gainVal;
+        qDebug() << "Thickness (mm):" << thickness;
         qDebug() << "Message:" << stringVal;
         qDebug() << "Selected Option:" << comboOptions[comboIndex] << "(" << comboIndex << ")";
         qDebug() << "Color:" << colorVal.name();
         qDebug() << "Config File:" << filePath;
         qDebug() << "Data Dir:" << dirPath;
+        qDebug() << "Mask Image:" << imagePath;
+        qDebug() << "Gamma(0.25):" << CurveEditor::evaluate(gammaCurve, 0.25);
         qDebug() << "Enabled:" << boolVal;
         qDebug() << "Font:" << fontVal.toString();
         qDebug() << "Password:" << password;
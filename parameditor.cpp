@@ -0,0 +1,5633 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file parameditor.cpp
+ * @brief Implementation of the parameter editor classes declared in parameditor.h.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ */
+
+#include "parameditor.h"
+#include "parameditor_p.h"
+#include <QtWidgets>
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <random>
+
+/* -------------------------------------
+   Compact Spin Boxes
+   ------------------------------------- */
+
+QSize CompactSpinBox::sizeHint() const { return hint(false); }
+
+QSize CompactSpinBox::minimumSizeHint() const { return hint(true); }
+
+QSize CompactSpinBox::hint(bool least) const {
+    ensurePolished();
+    const int digits = CompactDoubleSpinBox::integerDigits(QSpinBox::minimum(), maximum());
+    QString text = prefix();
+    if (QSpinBox::minimum() < 0) text += QLatin1Char('-');
+    text += QString(digits, QLatin1Char('9')) + suffix();
+    QStyleOptionSpinBox option;
+    initStyleOption(&option);
+    const QSize edit = least ? lineEdit()->minimumSizeHint() : lineEdit()->sizeHint();
+    return CompactDoubleSpinBox::cachedHint(this, option, text, edit.height());
+}
+
+QSize CompactDoubleSpinBox::sizeHint() const { return hint(false); }
+
+QSize CompactDoubleSpinBox::minimumSizeHint() const { return hint(true); }
+
+QSize CompactDoubleSpinBox::hint(bool least) const {
+    ensurePolished();
+    QString number(integerDigits(QDoubleSpinBox::minimum(), maximum()), QLatin1Char('9'));
+    if (decimals() > 0)
+        number += QLatin1Char('.') + QString(decimals(), QLatin1Char('9'));
+    if (QDoubleSpinBox::minimum() < 0) number.prepend(QLatin1Char('-'));
+    number.truncate(MaxChars);
+    QStyleOptionSpinBox option;
+    initStyleOption(&option);
+    const QSize edit = least ? lineEdit()->minimumSizeHint() : lineEdit()->sizeHint();
+    return cachedHint(this, option, prefix() + number + suffix(), edit.height());
+}
+
+QSize CompactDoubleSpinBox::cachedHint(const QAbstractSpinBox* box, const QStyleOptionSpinBox& option,
+    const QString& text, int editHeight) {
+    // GUI thread only, like the widgets; a few entries per font and style
+    static QHash<QString, QSize> cache;
+    const QString key = box->font().key() + QLatin1Char('\n') + box->style()->objectName()
+        + QLatin1Char('\n') + QString::number(editHeight) + QLatin1Char(option.frame ? 'f' : '-')
+        + QString::number(int(option.buttonSymbols)) + QLatin1Char('\n') + text;
+    auto it = cache.constFind(key);
+    if (it != cache.constEnd()) return it.value();
+    // As QAbstractSpinBox::sizeHint(): text, a space and room for the cursor
+    const int width = box->fontMetrics().horizontalAdvance(text + QLatin1Char(' ')) + 2;
+    const QSize size = box->style()->sizeFromContents(QStyle::CT_SpinBox, &option, QSize(width, editHeight), box)
+        .expandedTo(QApplication::globalStrut());
+    cache.insert(key, size);
+    return size;
+}
+
+int CompactDoubleSpinBox::integerDigits(double min, double max) {
+    const double magnitude = qMax(std::fabs(min), std::fabs(max));
+    if (!(magnitude >= 10.0)) return 1;
+    if (magnitude >= 1e10) return CompactSpinBox::MaxDigits;
+    return qMin(int(std::floor(std::log10(magnitude))) + 1, int(CompactSpinBox::MaxDigits));
+}
+
+/* -------------------------------------
+   Units
+   ------------------------------------- */
+
+ParamUnits::ParamUnits() {
+    const QString micro(QChar(0x00B5));
+    const QString degree(QChar(0x00B0));
+    define("length", "mm", 1.0);
+    define("length", micro + "m", 1e-3);
+    define("length", "m", 1e3);
+    define("length", "in", 25.4);
+    define("frequency", "Hz", 1.0);
+    define("frequency", "kHz", 1e3);
+    define("frequency", "MHz", 1e6);
+    define("time", "s", 1.0);
+    define("time", "ms", 1e-3);
+    define("time", micro + "s", 1e-6);
+    define("angle", "deg", 1.0);
+    define("angle", "rad", 180.0 / M_PI);
+    define("temperature", degree + "C", 1.0);
+    define("temperature", "K", 1.0, -273.15);
+    define("temperature", degree + "F", 5.0 / 9.0, -160.0 / 9.0);
+}
+
+ParamUnits& ParamUnits::instance() {
+    static ParamUnits units;
+    return units;
+}
+
+void ParamUnits::define(const QString& dimension, const QString& unit, double scale, double offset) {
+    UnitConversion conversion;
+    conversion.unit = unit;
+    conversion.scale = scale;
+    conversion.offset = offset;
+    conversion.invScale = scale != 0.0 ? 1.0 / scale : 0.0;
+    QVector<UnitConversion>& units = dimensions[dimension];
+    for (UnitConversion& existing : units) {
+        if (existing.unit == unit) {
+            existing = conversion;
+            return;
+        }
+    }
+    units.append(conversion);
+}
+
+UnitConversion ParamUnits::conversion(const QString& dimension, const QString& unit) const {
+    const auto it = dimensions.constFind(dimension);
+    if (it == dimensions.constEnd() || it->isEmpty()) return UnitConversion();
+    for (const UnitConversion& c : *it)
+        if (c.unit == unit)
+            return c;
+    return it->first();
+}
+
+QStringList ParamUnits::units(const QString& dimension) const {
+    QStringList symbols;
+    for (const UnitConversion& c : dimensions.value(dimension))
+        symbols << c.unit;
+    return symbols;
+}
+
+void UnitSpinBox::setCanonicalRange(double min, double max) {
+    canonicalMin = min;
+    canonicalMax = max;
+    setRange(conv.toDisplay(min), conv.toDisplay(max));
+}
+
+void UnitSpinBox::setCanonicalStep(double step) {
+    canonicalStep = step;
+    setSingleStep(step * conv.invScale);
+}
+
+void UnitSpinBox::setCanonicalValue(double v) {
+    canonical = qBound(canonicalMin, v, canonicalMax);
+    shown = qQNaN();
+    setValue(conv.toDisplay(canonical));
+    shown = value();
+}
+
+double UnitSpinBox::canonicalValue() const { return value() == shown ? canonical : conv.toCanonical(value()); }
+
+void UnitSpinBox::setConversion(const UnitConversion& c) {
+    const double v = canonicalValue();
+    if (baseDecimals < 0) baseDecimals = decimals();
+    QSignalBlocker block(this);
+    conv = c;
+    setDecimals(qBound(0, baseDecimals + qRound(std::log10(c.scale)), 10));
+    setRange(c.toDisplay(canonicalMin), c.toDisplay(canonicalMax));
+    setSingleStep(canonicalStep * c.invScale);
+    setSuffix(c.unit.isEmpty() ? QString() : QLatin1Char(' ') + c.unit);
+    setCanonicalValue(v);
+}
+
+void UnitSpinBox::restoreDefaults() {
+    QSignalBlocker block(this);
+    conv = UnitConversion();
+    baseDecimals = -1;
+    canonicalMin = 0.0;
+    canonicalMax = 99.99;
+    canonicalStep = 1.0;
+    setDecimals(2);
+    setRange(canonicalMin, canonicalMax);
+    setSingleStep(canonicalStep);
+    setSuffix(QString());
+    setCanonicalValue(0.0);
+}
+
+/* -------------------------------------
+   Editor Widget Pool
+   ------------------------------------- */
+
+/// Free widgets by exact type, and the capacity per type.
+struct WidgetPoolState {
+    QHash<const QMetaObject*, QVector<QWidget*>>    free;
+    int                                             capacity = ParamWidgetPool::DefaultCapacity;
+    bool                                            quitConnected = false;
+    bool                                            quitting = false; ///< True once the application is quitting: nothing is kept.
+};
+
+static WidgetPoolState& widgetPool() {
+    static WidgetPoolState state;
+    if (!state.quitConnected && qApp) {
+        // Unparented widgets must go before the application object does
+        state.quitConnected = true;
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, []() {
+            widgetPool().quitting = true;
+            ParamWidgetPool::trim();
+            });
+    }
+    return state;
+}
+
+static bool isPooledType(const QMetaObject* type) {
+    return type == &QLineEdit::staticMetaObject || type == &QCheckBox::staticMetaObject
+        || type == &CompactSpinBox::staticMetaObject || type == &UnitSpinBox::staticMetaObject;
+}
+
+void ParamWidgetPool::release(QWidget* w) {
+    if (!w) return;
+    WidgetPoolState& pool = widgetPool();
+    const QMetaObject* type = w->metaObject();
+    QVector<QWidget*>& list = pool.free[type];
+    if (pool.quitting || !isPooledType(type) || list.size() >= pool.capacity) {
+        delete w;
+        return;
+    }
+    resetWidget(w);
+    w->setParent(nullptr);
+    list.append(w);
+}
+
+void ParamWidgetPool::setCapacity(int perType) {
+    widgetPool().capacity = qMax(0, perType);
+    trim(widgetPool().capacity);
+}
+
+int ParamWidgetPool::capacity() { return widgetPool().capacity; }
+
+int ParamWidgetPool::freeCount() {
+    int count = 0;
+    for (const QVector<QWidget*>& list : widgetPool().free) count += list.size();
+    return count;
+}
+
+void ParamWidgetPool::trim(int keepPerType) {
+    for (QVector<QWidget*>& list : widgetPool().free) {
+        while (list.size() > qMax(0, keepPerType))
+            delete list.takeLast();
+    }
+}
+
+QWidget* ParamWidgetPool::takeFree(const QMetaObject* type) {
+    WidgetPoolState& pool = widgetPool();
+    auto it = pool.free.find(type);
+    if (it == pool.free.end() || it->isEmpty()) return nullptr;
+    return it->takeLast();
+}
+
+void ParamWidgetPool::resetWidget(QWidget* w) {
+    // Connections to the former owner go away with it: it is being destroyed
+    QSignalBlocker block(w);
+    w->setEnabled(true);
+    w->setToolTip(QString());
+    w->setPalette(QPalette());
+    w->setMinimumSize(0, 0);
+    w->setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+
+    if (QAbstractSpinBox* box = qobject_cast<QAbstractSpinBox*>(w)) {
+        box->setReadOnly(false);
+        box->setSpecialValueText(QString());
+        box->setWrapping(false);
+        box->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+        box->setButtonSymbols(QAbstractSpinBox::UpDownArrows);
+        box->setKeyboardTracking(true);
+        box->setFrame(true);
+        box->setAccelerated(false);
+        box->setCorrectionMode(QAbstractSpinBox::CorrectToPreviousValue);
+    }
+    if (UnitSpinBox* unitSpin = qobject_cast<UnitSpinBox*>(w)) {
+        unitSpin->setPrefix(QString());
+        unitSpin->restoreDefaults();
+    }
+    else if (QSpinBox* spin = qobject_cast<QSpinBox*>(w)) {
+        spin->setPrefix(QString());
+        spin->setSuffix(QString());
+        spin->setDisplayIntegerBase(10);
+        spin->setRange(0, 99);
+        spin->setSingleStep(1);
+        spin->setValue(0);
+    }
+    else if (QLineEdit* edit = qobject_cast<QLineEdit*>(w)) {
+        edit->setValidator(nullptr);
+        edit->setCompleter(nullptr);
+        edit->setInputMask(QString());
+        edit->setMaxLength(32767);
+        edit->setEchoMode(QLineEdit::Normal);
+        edit->setReadOnly(false);
+        edit->setInputMethodHints(Qt::ImhNone);
+        edit->setPlaceholderText(QString());
+        edit->setClearButtonEnabled(false);
+        edit->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+        edit->setFrame(true);
+        edit->clear();
+    }
+    else if (QCheckBox* check = qobject_cast<QCheckBox*>(w)) {
+        check->setTristate(false);
+        check->setChecked(false);
+        check->setText(QString());
+    }
+}
+
+ParamBase::~ParamBase() {
+    for (const QPointer<QWidget>& w : pooledWidgets) {
+        if (w && w->parentWidget() == this)
+            ParamWidgetPool::release(w);
+    }
+}
+
+void ParamBase::setUnit(const QString& dimension, const QString& displayUnit) {
+    unitDim = dimension;
+    setDisplayUnit(ParamUnits::instance().conversion(dimension, displayUnit));
+}
+
+void ParamBase::setCommitPolicy(CommitPolicy policy, int debounceMs) {
+    commitEdit();
+    ownPolicy = policy;
+    ownDebounce = debounceMs;
+}
+
+void ParamBase::setInheritedCommitPolicy(CommitPolicy policy, int debounceMs) {
+    commitEdit();
+    inheritedPolicy = policy == InheritCommit ? CommitPerKeystroke : policy;
+    inheritedDebounce = debounceMs;
+}
+
+ParamBase::CommitPolicy ParamBase::commitPolicy() const { return ownPolicy != InheritCommit ? ownPolicy : inheritedPolicy; }
+
+void ParamBase::commitEdit() {
+    if (!editPending) return;
+    editPending = false;
+    if (debounce) debounce->stop();
+    emit changed();
+}
+
+void ParamBase::textEdited(QWidget* field) {
+    // Only typing happens with the focus in the field; values set by code commit at once
+    const QWidget* focus = QApplication::focusWidget();
+    if (!focus || (focus != field && !field->isAncestorOf(focus))) {
+        editPending = true;
+        commitEdit();
+        return;
+    }
+    editPending = true;
+    ParamLatency::input(this);
+    if (commitPolicy() != CommitPerKeystroke) return;
+    const int delay = ownPolicy != InheritCommit ? ownDebounce : inheritedDebounce;
+    if (delay <= 0) {
+        commitEdit();
+        return;
+    }
+    if (!debounce) {
+        debounce = new QTimer(this);
+        debounce->setSingleShot(true);
+        connect(debounce, &QTimer::timeout, this, &ParamBase::commitEdit);
+    }
+    debounce->start(delay);
+}
+
+void ParamBase::throttledChanged() {
+    if (gestureMs <= 0 || !lastGestureEmit.isValid() || lastGestureEmit.elapsed() >= gestureMs) {
+        if (throttle) throttle->stop();
+        lastGestureEmit.start();
+        emit changed();
+        return;
+    }
+    if (!throttle) {
+        throttle = new QTimer(this);
+        throttle->setSingleShot(true);
+        connect(throttle, &QTimer::timeout, this, [this]() {
+            lastGestureEmit.start();
+            emit changed();
+            });
+    }
+    if (!throttle->isActive())
+        throttle->start(int(gestureMs - lastGestureEmit.elapsed()));
+}
+
+void ParamBase::endGesture() {
+    if (throttle) throttle->stop();
+    lastGestureEmit.invalidate();
+    emit changed();
+}
+
+void ParamBase::trackCommit(QWidget* field) {
+    QLineEdit* edit = qobject_cast<QLineEdit*>(field);
+    if (!edit) edit = field->findChild<QLineEdit*>();
+    if (edit)
+        connect(edit, &QLineEdit::returnPressed, this, [this]() { finishEdit(true); });
+    if (QAbstractSpinBox* box = qobject_cast<QAbstractSpinBox*>(field))
+        connect(box, &QAbstractSpinBox::editingFinished, this, [this]() { finishEdit(false); });
+    else if (edit)
+        connect(edit, &QLineEdit::editingFinished, this, [this]() { finishEdit(false); });
+}
+
+void ParamBase::finishEdit(bool enter) {
+    if (!enter && commitPolicy() == CommitOnEnter) return;
+    if (editPending) ParamLatency::input(this);
+    commitEdit();
+}
+
+void ParamBase::trackEdits() {
+    if (!beginTracking()) return;
+    for (QWidget* w : findChildren<QWidget*>()) {
+        if (QSpinBox* spin = qobject_cast<QSpinBox*>(w)) {
+            connect(spin, QOverload<int>::of(&QSpinBox::valueChanged), this, [this, spin]() { textEdited(spin); });
+            trackCommit(spin);
+        }
+        else if (QDoubleSpinBox* dspin = qobject_cast<QDoubleSpinBox*>(w)) {
+            connect(dspin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this, dspin]() { textEdited(dspin); });
+            trackCommit(dspin);
+        }
+        else if (QDateTimeEdit* dtEdit = qobject_cast<QDateTimeEdit*>(w)) {
+            connect(dtEdit, &QDateTimeEdit::dateTimeChanged, this, [this, dtEdit]() { textEdited(dtEdit); });
+            trackCommit(dtEdit);
+        }
+        else if (CompoundEditor* compound = qobject_cast<CompoundEditor*>(w))
+            connect(compound, &CompoundEditor::valueChanged, this, &ParamBase::changed);
+        else if (QComboBox* combo = qobject_cast<QComboBox*>(w)) {
+            if (combo->isEditable()) {
+                connect(combo, &QComboBox::currentTextChanged, this, [this, combo]() { textEdited(combo); });
+                trackCommit(combo);
+            }
+            else
+                connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ParamBase::changed);
+        }
+        else if (QLineEdit* edit = qobject_cast<QLineEdit*>(w)) {
+            // Line edits owned by spin boxes and combo boxes are covered above
+            if (!qobject_cast<QAbstractSpinBox*>(edit->parent()) && !qobject_cast<QComboBox*>(edit->parent())) {
+                connect(edit, &QLineEdit::textChanged, this, [this, edit]() { textEdited(edit); });
+                trackCommit(edit);
+            }
+        }
+        else if (QAbstractButton* button = qobject_cast<QAbstractButton*>(w)) {
+            if (button->isCheckable())
+                connect(button, &QAbstractButton::toggled, this, &ParamBase::changed);
+        }
+    }
+}
+
+DoubleParam::DoubleParam(QString name, double* p, double min, double max, double step, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = *p;
+    spin = pooled<UnitSpinBox>();
+    spin->setCanonicalRange(min, max);
+    spin->setCanonicalStep(step);
+    spin->setCanonicalValue(*p);
+    spin->setToolTip(tip);
+    spin->setAlignment(Qt::AlignRight);
+    widget = spin;
+}
+
+void DoubleParam::apply() { *ptr = spin->canonicalValue(); }
+
+void DoubleParam::reset() { spin->setCanonicalValue(defVal); }
+
+double DoubleParam::minimum() const { return spin->canonicalMinimum(); }
+
+double DoubleParam::maximum() const { return spin->canonicalMaximum(); }
+
+QVariant DoubleParam::storedValue() const { return *ptr; }
+
+QVariant DoubleParam::value() const { return spin->canonicalValue(); }
+
+void DoubleParam::setValue(const QVariant& v) { spin->setCanonicalValue(v.toDouble()); }
+
+void DoubleParam::setDisplayUnit(const UnitConversion& unit) { spin->setConversion(unit); }
+
+void DoubleParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", QString::number(spin->canonicalValue()));
+    w.writeEndElement();
+}
+
+void DoubleParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        spin->setCanonicalValue(r.attributes().value("value").toDouble());
+    r.readNext();
+}
+
+IntParam::IntParam(QString name, int* p, int min, int max, int step, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = *p;
+    spin = pooled<CompactSpinBox>();
+    spin->setRange(min, max);
+    spin->setSingleStep(step);
+    spin->setValue(*p);
+    spin->setToolTip(tip);
+    spin->setAlignment(Qt::AlignRight);
+    widget = spin;
+}
+
+void IntParam::apply() { *ptr = spin->value(); }
+
+void IntParam::reset() { spin->setValue(defVal); }
+
+int IntParam::minimum() const { return spin->minimum(); }
+
+int IntParam::maximum() const { return spin->maximum(); }
+
+QVariant IntParam::storedValue() const { return *ptr; }
+
+QVariant IntParam::value() const { return spin->value(); }
+
+void IntParam::setValue(const QVariant& v) { spin->setValue(v.toInt()); }
+
+void IntParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", QString::number(spin->value()));
+    w.writeEndElement();
+}
+
+void IntParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        spin->setValue(r.attributes().value("value").toInt());
+    r.readNext();
+}
+
+QRegularExpression PatternValidator::compiled(const QString& pattern) {
+    static QCache<QString, QRegularExpression> cache(CacheCapacity);
+    if (const QRegularExpression* cached = cache.object(pattern)) return *cached;
+    QRegularExpression re(QRegularExpression::anchoredPattern(pattern));
+    re.optimize();
+    if (!re.isValid())
+        qWarning() << "Invalid pattern" << pattern << ":" << re.errorString();
+    cache.insert(pattern, new QRegularExpression(re));
+    return re;
+}
+
+void PatternValidator::setPattern(const QString& pattern) {
+    active = !pattern.isEmpty();
+    regex = active ? compiled(pattern) : QRegularExpression();
+}
+
+void PatternValidator::bind(ParamBase* owner, QLineEdit* edit, const QString& pattern) {
+    if (!bound) {
+        bound = true;
+        QObject::connect(edit, &QLineEdit::textChanged, owner, [this, owner, edit]() {
+            if (check(edit))
+                emit owner->validityChanged(valid);
+            });
+    }
+    setPattern(pattern);
+    if (check(edit))
+        emit owner->validityChanged(valid);
+}
+
+QString PatternValidator::pattern() const { return active ? regex.pattern() : QString(); }
+
+bool PatternValidator::check(QLineEdit* edit) {
+    const bool ok = !active || regex.match(edit->text()).hasMatch();
+    if (ok == valid) return false;
+    valid = ok;
+    if (ok) {
+        edit->setPalette(QPalette());
+    }
+    else {
+        QPalette pal = edit->palette();
+        pal.setColor(QPalette::Base, QColor(255, 215, 215));
+        edit->setPalette(pal);
+    }
+    return true;
+}
+
+StringParam::StringParam(QString name, QString* p, QString def, Qt::InputMethodHints hints, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    edit = pooled<QLineEdit>();
+    edit->setText(*p);
+    edit->setInputMethodHints(hints);
+    edit->setToolTip(tip);
+    widget = edit;
+}
+
+void StringParam::setPattern(const QString& pattern) { validator.bind(this, edit, pattern); }
+
+bool StringParam::isValid() const { return validator.isValid(); }
+
+void StringParam::apply() { *ptr = edit->text(); }
+
+void StringParam::reset() { edit->setText(defVal); }
+
+QVariant StringParam::storedValue() const { return *ptr; }
+
+QVariant StringParam::value() const { return edit->text(); }
+
+void StringParam::setValue(const QVariant& v) { edit->setText(v.toString()); }
+
+void StringParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", edit->text());
+    w.writeEndElement();
+}
+
+void StringParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        edit->setText(r.attributes().value("value").toString());
+    r.readNext();
+}
+
+ComboParam::ComboParam(QString name, QStringList* opts, int* p, int defIndex, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    options = opts;
+    ptr = p;
+    defVal = defIndex;
+    combo = new QComboBox(this);
+    combo->addItems(*opts);
+    combo->setCurrentIndex(*p);
+    combo->setToolTip(tip);
+    widget = combo;
+}
+
+void ComboParam::apply() { *ptr = combo->currentIndex(); }
+
+void ComboParam::reset() { combo->setCurrentIndex(defVal); }
+
+QStringList ComboParam::items() const { return *options; }
+
+QVariant ComboParam::storedValue() const { return *ptr; }
+
+QVariant ComboParam::value() const { return combo->currentIndex(); }
+
+void ComboParam::setValue(const QVariant& v) { combo->setCurrentIndex(v.toInt()); }
+
+void ComboParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("index", QString::number(combo->currentIndex()));
+    w.writeEndElement();
+}
+
+void ComboParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("index"))
+        combo->setCurrentIndex(r.attributes().value("index").toInt());
+    r.readNext();
+}
+
+ColorParam::ColorParam(QString name, QColor* p, QColor def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    btn = new QPushButton(this);
+    updateButton(*ptr);
+    btn->setToolTip(tip);
+    // The colour is shown only: apply() writes it, so Cancel and the audit log see the change
+    QObject::connect(btn, &QPushButton::clicked, [this, name]() {
+        const QColor c = QColorDialog::getColor(current, nullptr, name);
+        if (c.isValid())
+            updateButton(c);
+        });
+    widget = btn;
+}
+
+void ColorParam::apply() { *ptr = current; }
+
+void ColorParam::reset() { updateButton(defVal); }
+
+QVariant ColorParam::storedValue() const { return *ptr; }
+
+void ColorParam::setValue(const QVariant& v) { updateButton(v.value<QColor>()); }
+
+void ColorParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("color", current.name());
+    w.writeEndElement();
+}
+
+void ColorParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("color"))
+        updateButton(QColor(r.attributes().value("color").toString()));
+    r.readNext();
+}
+
+void ColorParam::updateButton(const QColor& c) {
+    current = c;
+    btn->setStyleSheet(QString("QPushButton { background-color: %1; border: 1px solid black; }").arg(c.name()));
+    btn->setAutoFillBackground(true);
+    btn->update();
+    emit changed();
+}
+
+FilePathParam::FilePathParam(QString name, QString* p, QString def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    edit = pooled<QLineEdit>();
+    edit->setText(*p);
+    edit->setToolTip(tip);
+    widget = edit;
+    browseButton = nullptr;
+}
+
+void FilePathParam::apply() { *ptr = edit->text(); }
+
+void FilePathParam::reset() { edit->setText(defVal); }
+
+QVariant FilePathParam::storedValue() const { return *ptr; }
+
+QVariant FilePathParam::value() const { return edit->text(); }
+
+void FilePathParam::setValue(const QVariant& v) { edit->setText(v.toString()); }
+
+void FilePathParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("path", edit->text());
+    w.writeEndElement();
+}
+
+void FilePathParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("path"))
+        edit->setText(r.attributes().value("path").toString());
+    r.readNext();
+}
+
+void FilePathParam::onBrowseClicked() {
+    QString file = QFileDialog::getOpenFileName(widget, "Select File", edit->text());
+    if (!file.isEmpty())
+        edit->setText(file);
+}
+
+DirParam::DirParam(QString name, QString* p, QString def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    edit = pooled<QLineEdit>();
+    edit->setText(*p);
+    edit->setToolTip(tip);
+    widget = edit;
+    browseButton = nullptr;
+}
+
+void DirParam::apply() { *ptr = edit->text(); }
+
+void DirParam::reset() { edit->setText(defVal); }
+
+QVariant DirParam::storedValue() const { return *ptr; }
+
+QVariant DirParam::value() const { return edit->text(); }
+
+void DirParam::setValue(const QVariant& v) { edit->setText(v.toString()); }
+
+void DirParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("path", edit->text());
+    w.writeEndElement();
+}
+
+void DirParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("path"))
+        edit->setText(r.attributes().value("path").toString());
+    r.readNext();
+}
+
+void DirParam::onBrowseClicked() {
+    QString dir = QFileDialog::getExistingDirectory(widget, "Select Directory", edit->text());
+    if (!dir.isEmpty())
+        edit->setText(dir);
+}
+
+BoolParam::BoolParam(QString name, bool* p, bool def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    checkBox = pooled<QCheckBox>();
+    checkBox->setChecked(*p);
+    checkBox->setToolTip(tip);
+    widget = checkBox;
+}
+
+void BoolParam::apply() { *ptr = checkBox->isChecked(); }
+
+void BoolParam::reset() { checkBox->setChecked(defVal); }
+
+QVariant BoolParam::storedValue() const { return *ptr; }
+
+QVariant BoolParam::value() const { return checkBox->isChecked(); }
+
+void BoolParam::setValue(const QVariant& v) { checkBox->setChecked(v.toBool()); }
+
+void BoolParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", checkBox->isChecked() ? "true" : "false");
+    w.writeEndElement();
+}
+
+void BoolParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        checkBox->setChecked(r.attributes().value("value").toString() == "true");
+    r.readNext();
+}
+
+FontParam::FontParam(QString name, QFont* p, QFont def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    currentFont = *p;
+    btn = new QPushButton(this);
+    updateButton(currentFont);
+    btn->setToolTip(tip);
+    QObject::connect(btn, &QPushButton::clicked, [this, name]() {
+        bool ok;
+        QFont font = QFontDialog::getFont(&ok, currentFont, nullptr, name);
+        if (ok) {
+            currentFont = font;
+            updateButton(font);
+        }
+        });
+    widget = btn;
+}
+
+void FontParam::apply() { *ptr = currentFont; }
+
+void FontParam::reset() {
+    currentFont = defVal;
+    updateButton(defVal);
+}
+
+QVariant FontParam::storedValue() const { return *ptr; }
+
+void FontParam::setValue(const QVariant& v) {
+    currentFont = v.value<QFont>();
+    updateButton(currentFont);
+}
+
+void FontParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", currentFont.toString());
+    w.writeEndElement();
+}
+
+void FontParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value")) {
+        currentFont.fromString(r.attributes().value("value").toString());
+        updateButton(currentFont);
+    }
+    r.readNext();
+}
+
+void FontParam::updateButton(const QFont& f) {
+    btn->setText(f.family() + " " + QString::number(f.pointSize()));
+    emit changed();
+}
+
+PasswordParam::PasswordParam(QString name, QString* p, QString def, QString tip, QWidget* parent)
+    : StringParam(name, p, def, Qt::ImhHiddenText, tip, parent) {
+    edit->setEchoMode(QLineEdit::Password);
+}
+
+DateTimeParam::DateTimeParam(QString name, QDateTime* p, QDateTime def,
+    QString tip, QString format,
+    QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    dateTimeEdit = new QDateTimeEdit(*p, this);
+    dateTimeEdit->setDisplayFormat(format);
+    dateTimeEdit->setToolTip(tip);
+    dateTimeEdit->setCalendarPopup(true);
+    widget = dateTimeEdit;
+}
+
+void DateTimeParam::apply() { *ptr = dateTimeEdit->dateTime(); }
+
+void DateTimeParam::reset() { dateTimeEdit->setDateTime(defVal); }
+
+QVariant DateTimeParam::storedValue() const { return *ptr; }
+
+QVariant DateTimeParam::value() const { return dateTimeEdit->dateTime(); }
+
+void DateTimeParam::setValue(const QVariant& v) { dateTimeEdit->setDateTime(v.toDateTime()); }
+
+void DateTimeParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", dateTimeEdit->dateTime().toString(Qt::ISODate));
+    w.writeEndElement();
+}
+
+void DateTimeParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value")) {
+        QDateTime dt = QDateTime::fromString(r.attributes().value("value").toString(), Qt::ISODate);
+        if (dt.isValid()) dateTimeEdit->setDateTime(dt);
+    }
+    r.readNext();
+}
+
+CompoundEditor::CompoundEditor(int decimals, QWidget* parent)
+    : QWidget(parent), decimals(decimals) {
+    setFocusPolicy(Qt::WheelFocus);
+    setAttribute(Qt::WA_InputMethodEnabled, false);
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+}
+
+int CompoundEditor::addField(const QString& label, double min, double max, double step, const QString& tip) {
+    Field f;
+    f.label = label;
+    f.tip = tip;
+    f.min = min;
+    f.max = max;
+    f.step = step;
+    f.value = qBound(min, 0.0, max);
+    fields.append(f);
+    layoutStale = true;
+    cachedHint = QSize();
+    updateGeometry();
+    return fields.size() - 1;
+}
+
+double CompoundEditor::value(int field) const { return fields[field].value; }
+
+void CompoundEditor::setValue(int field, double v) {
+    Field& f = fields[field];
+    v = qBound(f.min, v, f.max);
+    if (v == f.value) return;
+    f.value = v;
+    update(f.boxRect);
+    emit valueChanged(field);
+}
+
+double CompoundEditor::minimum(int field) const { return fields[field].min; }
+
+double CompoundEditor::maximum(int field) const { return fields[field].max; }
+
+void CompoundEditor::setConversion(const UnitConversion& c) {
+    if (editing >= 0) closeEditor(true);
+    conv = c;
+    if (spin) spin->setConversion(c);
+    layoutStale = true;
+    cachedHint = QSize();
+    updateGeometry();
+    update();
+}
+
+QSize CompoundEditor::sizeHint() const {
+    if (cachedHint.isEmpty()) {
+        ensurePolished();
+        const QFontMetrics fm = fontMetrics();
+        const int spacing = fm.horizontalAdvance(QLatin1Char(' '));
+        int w = 0;
+        for (int i = 0; i < fields.size(); ++i) {
+            if (!fields[i].label.isEmpty())
+                w += fm.horizontalAdvance(fields[i].label) + spacing;
+            w += boxWidth(i) + (i > 0 ? spacing : 0);
+        }
+        // Same height as a QLineEdit in this style
+        QStyleOptionFrame option;
+        option.initFrom(this);
+        option.lineWidth = style()->pixelMetric(QStyle::PM_DefaultFrameWidth, &option, this);
+        const QSize box = style()->sizeFromContents(QStyle::CT_LineEdit, &option, QSize(0, qMax(fm.height(), 14) + 2), this);
+        cachedHint = QSize(w, box.height()).expandedTo(QApplication::globalStrut());
+    }
+    return cachedHint;
+}
+
+QSize CompoundEditor::minimumSizeHint() const { return sizeHint(); }
+
+bool CompoundEditor::event(QEvent* e) {
+    if (e->type() == QEvent::ToolTip) {
+        QHelpEvent* help = static_cast<QHelpEvent*>(e);
+        const int field = fieldAt(help->pos());
+        const QString tip = field >= 0 && !fields[field].tip.isEmpty() ? fields[field].tip : toolTip();
+        if (tip.isEmpty()) QToolTip::hideText();
+        else QToolTip::showText(help->globalPos(), tip, this, field >= 0 ? fields[field].boxRect : QRect());
+        return true;
+    }
+    return QWidget::event(e);
+}
+
+bool CompoundEditor::eventFilter(QObject* watched, QEvent* e) {
+    // Handled here, since the spin box passes Enter and Escape on to its parents
+    if (editing >= 0 && e->type() == QEvent::KeyPress) {
+        const int key = static_cast<QKeyEvent*>(e)->key();
+        if (key == Qt::Key_Escape || key == Qt::Key_Return || key == Qt::Key_Enter) {
+            closeEditor(key != Qt::Key_Escape);
+            return true;
+        }
+    }
+    return QWidget::eventFilter(watched, e);
+}
+
+bool CompoundEditor::focusNextPrevChild(bool next) {
+    // Tab moves between the fields before leaving the editor
+    const int target = (editing >= 0 ? editing : current) + (next ? 1 : -1);
+    const bool wasEditing = editing >= 0;
+    if (wasEditing) closeEditor(true);
+    if (target >= 0 && target < fields.size() && (wasEditing || hasFocus())) {
+        current = target;
+        if (wasEditing) openEditor(target);
+        else update();
+        return true;
+    }
+    return QWidget::focusNextPrevChild(next);
+}
+
+QString CompoundEditor::text(int field) const {
+    const int shown = conv.scale == 1.0 ? decimals : qBound(0, decimals + qRound(std::log10(conv.scale)), 10);
+    QString s = locale().toString(conv.toDisplay(fields[field].value), 'f', shown);
+    if (!conv.unit.isEmpty()) s += QLatin1Char(' ') + conv.unit;
+    return s;
+}
+
+int CompoundEditor::boxWidth(int field) const {
+    const Field& f = fields[field];
+    const int shown = conv.scale == 1.0 ? decimals : qBound(0, decimals + qRound(std::log10(conv.scale)), 10);
+    QString number(CompactDoubleSpinBox::integerDigits(conv.toDisplay(f.min), conv.toDisplay(f.max)), QLatin1Char('9'));
+    if (shown > 0) number += QLatin1Char('.') + QString(shown, QLatin1Char('9'));
+    if (f.min < 0) number.prepend(QLatin1Char('-'));
+    number.truncate(CompactDoubleSpinBox::MaxChars);
+    if (!conv.unit.isEmpty()) number += QLatin1Char(' ') + conv.unit;
+    const int frame = style()->pixelMetric(QStyle::PM_DefaultFrameWidth, nullptr, this);
+    return fontMetrics().horizontalAdvance(number) + 2 * frame + 6;
+}
+
+void CompoundEditor::layoutFields() {
+    layoutStale = false;
+    if (fields.isEmpty()) return;
+    const QFontMetrics fm = fontMetrics();
+    const int spacing = fm.horizontalAdvance(QLatin1Char(' '));
+    int labels = spacing * (fields.size() - 1);
+    for (const Field& f : qAsConst(fields))
+        if (!f.label.isEmpty())
+            labels += fm.horizontalAdvance(f.label) + spacing;
+    const int box = qMax(0, (width() - labels) / fields.size());
+    int x = 0;
+    for (int i = 0; i < fields.size(); ++i) {
+        Field& f = fields[i];
+        const int lw = f.label.isEmpty() ? 0 : fm.horizontalAdvance(f.label);
+        f.labelRect = QRect(x, 0, lw, height());
+        x += lw + (lw ? spacing : 0);
+        f.boxRect = QRect(x, 0, box, height());
+        x += box + spacing;
+    }
+    if (editing >= 0) spin->setGeometry(fields[editing].boxRect);
+}
+
+int CompoundEditor::fieldAt(const QPoint& pos) {
+    if (layoutStale) layoutFields();
+    for (int i = 0; i < fields.size(); ++i)
+        if (fields[i].labelRect.contains(pos) || fields[i].boxRect.contains(pos))
+            return i;
+    return -1;
+}
+
+void CompoundEditor::paintEvent(QPaintEvent* e) {
+    if (layoutStale) layoutFields();
+    QPainter painter(this);
+    QStyleOptionFrame option;
+    option.initFrom(this);
+    option.lineWidth = style()->pixelMetric(QStyle::PM_DefaultFrameWidth, &option, this);
+    option.midLineWidth = 0;
+    option.state |= QStyle::State_Sunken;
+    const QStyle::State base = option.state & ~QStyle::State_HasFocus;
+    for (int i = 0; i < fields.size(); ++i) {
+        const Field& f = fields[i];
+        if (!f.label.isEmpty() && f.labelRect.intersects(e->rect())) {
+            painter.setPen(palette().color(QPalette::WindowText));
+            painter.drawText(f.labelRect, Qt::AlignRight | Qt::AlignVCenter, f.label);
+        }
+        if (i == editing || !f.boxRect.intersects(e->rect())) continue;
+        option.rect = f.boxRect;
+        option.state = base;
+        if (hasFocus() && i == current) option.state |= QStyle::State_HasFocus;
+        style()->drawPrimitive(QStyle::PE_PanelLineEdit, &option, &painter, this);
+        const QRect textRect = style()->subElementRect(QStyle::SE_LineEditContents, &option, this).adjusted(2, 0, -2, 0);
+        painter.setPen(palette().color(isEnabled() ? QPalette::Active : QPalette::Disabled, QPalette::Text));
+        painter.drawText(textRect, Qt::AlignRight | Qt::AlignVCenter, text(i));
+    }
+}
+
+void CompoundEditor::resizeEvent(QResizeEvent* e) {
+    layoutStale = true;
+    QWidget::resizeEvent(e);
+}
+
+void CompoundEditor::changeEvent(QEvent* e) {
+    if (e->type() == QEvent::FontChange || e->type() == QEvent::StyleChange || e->type() == QEvent::LocaleChange) {
+        layoutStale = true;
+        cachedHint = QSize();
+        updateGeometry();
+    }
+    QWidget::changeEvent(e);
+}
+
+void CompoundEditor::focusInEvent(QFocusEvent* e) {
+    if (e->reason() == Qt::TabFocusReason) current = 0;
+    else if (e->reason() == Qt::BacktabFocusReason) current = qMax(0, fields.size() - 1);
+    update();
+    QWidget::focusInEvent(e);
+}
+
+void CompoundEditor::focusOutEvent(QFocusEvent* e) {
+    update();
+    QWidget::focusOutEvent(e);
+}
+
+void CompoundEditor::mousePressEvent(QMouseEvent* e) {
+    const int field = fieldAt(e->pos());
+    if (field < 0 || e->button() != Qt::LeftButton) {
+        QWidget::mousePressEvent(e);
+        return;
+    }
+    current = field;
+    if (fields[field].boxRect.contains(e->pos())) openEditor(field);
+    else update();
+}
+
+void CompoundEditor::keyPressEvent(QKeyEvent* e) {
+    if (fields.isEmpty()) {
+        QWidget::keyPressEvent(e);
+        return;
+    }
+    switch (e->key()) {
+    case Qt::Key_Left:
+    case Qt::Key_Right: {
+        const int target = current + (e->key() == Qt::Key_Right ? 1 : -1);
+        if (target >= 0 && target < fields.size()) {
+            current = target;
+            update();
+        }
+        return;
+    }
+    case Qt::Key_Up: stepField(current, 1); return;
+    case Qt::Key_Down: stepField(current, -1); return;
+    case Qt::Key_PageUp: stepField(current, 10); return;
+    case Qt::Key_PageDown: stepField(current, -10); return;
+    case Qt::Key_Return:
+    case Qt::Key_Enter:
+    case Qt::Key_F2:
+        openEditor(current);
+        return;
+    default:
+        break;
+    }
+    // Typing a number starts editing the field with it
+    const QString typed = e->text();
+    if (!typed.isEmpty() && (typed.at(0).isDigit() || typed.at(0) == QLatin1Char('-')
+        || typed.at(0) == locale().decimalPoint())) {
+        openEditor(current);
+        QCoreApplication::sendEvent(spin, e);
+        return;
+    }
+    QWidget::keyPressEvent(e);
+}
+
+void CompoundEditor::wheelEvent(QWheelEvent* e) {
+    // Only a focused editor takes the wheel, so scrolling a page over it still scrolls
+    const int field = hasFocus() ? fieldAt(e->position().toPoint()) : -1;
+    const int steps = e->angleDelta().y() / 120;
+    if (field < 0 || steps == 0) {
+        e->ignore();
+        return;
+    }
+    current = field;
+    stepField(field, steps);
+}
+
+void CompoundEditor::stepField(int field, int steps) {
+    setValue(field, fields[field].value + steps * fields[field].step);
+}
+
+void CompoundEditor::openEditor(int field) {
+    if (editing >= 0) closeEditor(true);
+    if (layoutStale) layoutFields();
+    if (!spin) {
+        spin = new UnitSpinBox(this);
+        spin->setDecimals(decimals);
+        spin->setConversion(conv);
+        spin->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        spin->setButtonSymbols(QAbstractSpinBox::NoButtons);
+        spin->installEventFilter(this);
+        connect(spin, &QAbstractSpinBox::editingFinished, this, [this]() { closeEditor(true); });
+    }
+    const Field& f = fields[field];
+    editing = field;
+    current = field;
+    spin->setCanonicalRange(f.min, f.max);
+    spin->setCanonicalStep(f.step);
+    spin->setCanonicalValue(f.value);
+    spin->setToolTip(f.tip);
+    spin->setGeometry(f.boxRect);
+    spin->show();
+    spin->setFocus(Qt::OtherFocusReason);
+    spin->selectAll();
+}
+
+void CompoundEditor::closeEditor(bool commit) {
+    if (editing < 0) return;
+    const int field = editing;
+    editing = -1;
+    if (commit) spin->interpretText();
+    const double v = spin->canonicalValue();
+    // Keep the focus here rather than letting hide() pass it to the next widget
+    if (spin->hasFocus()) setFocus(Qt::OtherFocusReason);
+    spin->hide();
+    update(fields[field].boxRect);
+    if (commit) setValue(field, v);
+}
+
+RangeParam::RangeParam(QString name, QPair<double, double>* p,
+    double globalMin, double globalMax, double step,
+    QPair<double, double> def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    editor = new CompoundEditor(2, this);
+    editor->addField(QString(), globalMin, globalMax, step, tip + " (Minimum)");
+    editor->addField("to", globalMin, globalMax, step, tip + " (Maximum)");
+    editor->setValue(0, p->first);
+    editor->setValue(1, p->second);
+    editor->setToolTip(tip);
+
+    widget = editor;
+}
+
+void RangeParam::apply() {
+    ptr->first = editor->value(0);
+    ptr->second = editor->value(1);
+}
+
+void RangeParam::reset() {
+    editor->setValue(0, defVal.first);
+    editor->setValue(1, defVal.second);
+}
+
+double RangeParam::minimum() const { return editor->minimum(0); }
+
+double RangeParam::maximum() const { return editor->maximum(0); }
+
+QVariant RangeParam::storedValue() const { return QVariantList{ ptr->first, ptr->second }; }
+
+QVariant RangeParam::value() const { return QVariantList{ editor->value(0), editor->value(1) }; }
+
+void RangeParam::setValue(const QVariant& v) {
+    const QVariantList range = v.toList();
+    if (range.size() != 2) return;
+    editor->setValue(0, range.at(0).toDouble());
+    editor->setValue(1, range.at(1).toDouble());
+}
+
+void RangeParam::setDisplayUnit(const UnitConversion& unit) { editor->setConversion(unit); }
+
+void RangeParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("min", QString::number(editor->value(0)));
+    w.writeAttribute("max", QString::number(editor->value(1)));
+    w.writeEndElement();
+}
+
+void RangeParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("min") && r.attributes().hasAttribute("max")) {
+        editor->setValue(0, r.attributes().value("min").toDouble());
+        editor->setValue(1, r.attributes().value("max").toDouble());
+    }
+    r.readNext();
+}
+
+StringListParam::StringListParam(QString name, QStringList* p, QStringList def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    combo = new QComboBox(this);
+    combo->setEditable(true); // Permette di aggiungere nuovi elementi
+    combo->addItems(*p);
+    combo->setCurrentText(p->join(','));
+    combo->setToolTip(tip);
+    widget = combo;
+}
+
+void StringListParam::apply() {
+    *ptr = combo->currentText().split(",", Qt::SkipEmptyParts);
+}
+
+void StringListParam::reset() {
+    combo->clear();
+    combo->addItems(defVal);
+    combo->setCurrentText(defVal.join(','));
+}
+
+QVariant StringListParam::storedValue() const { return *ptr; }
+
+QVariant StringListParam::value() const { return combo->currentText().split(",", Qt::SkipEmptyParts); }
+
+// The list is the comma-separated text, as value() and apply() read it; the items are only choices
+void StringListParam::setValue(const QVariant& v) { combo->setCurrentText(v.toStringList().join(',')); }
+
+void StringListParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", combo->currentText());
+    w.writeEndElement();
+}
+
+void StringListParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        combo->setCurrentText(r.attributes().value("value").toString());
+    r.readNext();
+}
+
+DateParam::DateParam(QString name, QDate* p, QDate def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    dateEdit = new QDateEdit(*p, this);
+    dateEdit->setDisplayFormat("dd/MM/yyyy");
+    dateEdit->setToolTip(tip);
+    dateEdit->setCalendarPopup(true);
+    widget = dateEdit;
+}
+
+void DateParam::apply() { *ptr = dateEdit->date(); }
+
+void DateParam::reset() { dateEdit->setDate(defVal); }
+
+QVariant DateParam::storedValue() const { return *ptr; }
+
+QVariant DateParam::value() const { return dateEdit->date(); }
+
+void DateParam::setValue(const QVariant& v) { dateEdit->setDate(v.toDate()); }
+
+void DateParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", dateEdit->date().toString(Qt::ISODate));
+    w.writeEndElement();
+}
+
+void DateParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value")) {
+        QDate date = QDate::fromString(r.attributes().value("value").toString(), Qt::ISODate);
+        if (date.isValid()) dateEdit->setDate(date);
+    }
+    r.readNext();
+}
+
+TimeParam::TimeParam(QString name, QTime* p, QTime def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    timeEdit = new QTimeEdit(*p, this);
+    timeEdit->setDisplayFormat("hh:mm:ss");
+    timeEdit->setToolTip(tip);
+    widget = timeEdit;
+}
+
+void TimeParam::apply() { *ptr = timeEdit->time(); }
+
+void TimeParam::reset() { timeEdit->setTime(defVal); }
+
+QVariant TimeParam::storedValue() const { return *ptr; }
+
+QVariant TimeParam::value() const { return timeEdit->time(); }
+
+void TimeParam::setValue(const QVariant& v) { timeEdit->setTime(v.toTime()); }
+
+void TimeParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", timeEdit->time().toString(Qt::ISODate));
+    w.writeEndElement();
+}
+
+void TimeParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value")) {
+        QTime time = QTime::fromString(r.attributes().value("value").toString(), Qt::ISODate);
+        if (time.isValid()) timeEdit->setTime(time);
+    }
+    r.readNext();
+}
+
+PointParam::PointParam(QString name, QPoint* p, QPoint def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    editor = new CompoundEditor(0, this);
+    editor->addField("X:", INT_MIN, INT_MAX, 1, tip + " (X coordinate)");
+    editor->addField("Y:", INT_MIN, INT_MAX, 1, tip + " (Y coordinate)");
+    editor->setValue(0, p->x());
+    editor->setValue(1, p->y());
+    editor->setToolTip(tip);
+
+    widget = editor;
+}
+
+void PointParam::apply() {
+    ptr->setX(qRound(editor->value(0)));
+    ptr->setY(qRound(editor->value(1)));
+}
+
+void PointParam::reset() {
+    editor->setValue(0, defVal.x());
+    editor->setValue(1, defVal.y());
+}
+
+QVariant PointParam::storedValue() const { return *ptr; }
+
+QVariant PointParam::value() const { return QPoint(qRound(editor->value(0)), qRound(editor->value(1))); }
+
+void PointParam::setValue(const QVariant& v) {
+    const QPoint pt = v.toPoint();
+    editor->setValue(0, pt.x());
+    editor->setValue(1, pt.y());
+}
+
+void PointParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("x", QString::number(qRound(editor->value(0))));
+    w.writeAttribute("y", QString::number(qRound(editor->value(1))));
+    w.writeEndElement();
+}
+
+void PointParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("x") && r.attributes().hasAttribute("y")) {
+        editor->setValue(0, r.attributes().value("x").toInt());
+        editor->setValue(1, r.attributes().value("y").toInt());
+    }
+    r.readNext();
+}
+
+SizeParam::SizeParam(QString name, QSize* p, QSize def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    editor = new CompoundEditor(0, this);
+    editor->addField("Width:", 0, INT_MAX, 1, tip + " (Width)");
+    editor->addField("Height:", 0, INT_MAX, 1, tip + " (Height)");
+    editor->setValue(0, p->width());
+    editor->setValue(1, p->height());
+    editor->setToolTip(tip);
+
+    widget = editor;
+}
+
+void SizeParam::apply() {
+    ptr->setWidth(qRound(editor->value(0)));
+    ptr->setHeight(qRound(editor->value(1)));
+}
+
+void SizeParam::reset() {
+    editor->setValue(0, defVal.width());
+    editor->setValue(1, defVal.height());
+}
+
+QVariant SizeParam::storedValue() const { return *ptr; }
+
+QVariant SizeParam::value() const { return QSize(qRound(editor->value(0)), qRound(editor->value(1))); }
+
+void SizeParam::setValue(const QVariant& v) {
+    const QSize sz = v.toSize();
+    editor->setValue(0, sz.width());
+    editor->setValue(1, sz.height());
+}
+
+void SizeParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("width", QString::number(qRound(editor->value(0))));
+    w.writeAttribute("height", QString::number(qRound(editor->value(1))));
+    w.writeEndElement();
+}
+
+void SizeParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("width") && r.attributes().hasAttribute("height")) {
+        editor->setValue(0, r.attributes().value("width").toInt());
+        editor->setValue(1, r.attributes().value("height").toInt());
+    }
+    r.readNext();
+}
+
+RectParam::RectParam(QString name, QRect* p, QRect def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    editor = new CompoundEditor(0, this);
+    editor->addField("X:", INT_MIN, INT_MAX, 1, tip + " (X coordinate)");
+    editor->addField("Y:", INT_MIN, INT_MAX, 1, tip + " (Y coordinate)");
+    editor->addField("W:", 0, INT_MAX, 1, tip + " (Width)");
+    editor->addField("H:", 0, INT_MAX, 1, tip + " (Height)");
+    editor->setValue(0, p->x());
+    editor->setValue(1, p->y());
+    editor->setValue(2, p->width());
+    editor->setValue(3, p->height());
+    editor->setToolTip(tip);
+
+    widget = editor;
+}
+
+void RectParam::apply() {
+    *ptr = QRect(qRound(editor->value(0)), qRound(editor->value(1)), qRound(editor->value(2)), qRound(editor->value(3)));
+}
+
+void RectParam::reset() {
+    editor->setValue(0, defVal.x());
+    editor->setValue(1, defVal.y());
+    editor->setValue(2, defVal.width());
+    editor->setValue(3, defVal.height());
+}
+
+QVariant RectParam::storedValue() const { return *ptr; }
+
+QVariant RectParam::value() const { return QRect(qRound(editor->value(0)), qRound(editor->value(1)), qRound(editor->value(2)), qRound(editor->value(3))); }
+
+void RectParam::setValue(const QVariant& v) {
+    const QRect rc = v.toRect();
+    editor->setValue(0, rc.x());
+    editor->setValue(1, rc.y());
+    editor->setValue(2, rc.width());
+    editor->setValue(3, rc.height());
+}
+
+void RectParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("x", QString::number(qRound(editor->value(0))));
+    w.writeAttribute("y", QString::number(qRound(editor->value(1))));
+    w.writeAttribute("width", QString::number(qRound(editor->value(2))));
+    w.writeAttribute("height", QString::number(qRound(editor->value(3))));
+    w.writeEndElement();
+}
+
+void RectParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("x") && r.attributes().hasAttribute("y") &&
+        r.attributes().hasAttribute("width") && r.attributes().hasAttribute("height")) {
+        editor->setValue(0, r.attributes().value("x").toInt());
+        editor->setValue(1, r.attributes().value("y").toInt());
+        editor->setValue(2, r.attributes().value("width").toInt());
+        editor->setValue(3, r.attributes().value("height").toInt());
+    }
+    r.readNext();
+}
+
+VariantParam::VariantParam(QString name, QVariant* p, QVariant def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    edit = pooled<QLineEdit>();
+    edit->setText(p->toString());
+    edit->setToolTip(tip);
+    widget = edit;
+}
+
+void VariantParam::setPattern(const QString& pattern) { validator.bind(this, edit, pattern); }
+
+bool VariantParam::isValid() const { return validator.isValid(); }
+
+void VariantParam::apply() { *ptr = edit->text(); }
+
+void VariantParam::reset() { edit->setText(defVal.toString()); }
+
+QVariant VariantParam::storedValue() const { return *ptr; }
+
+QVariant VariantParam::value() const { return edit->text(); }
+
+void VariantParam::setValue(const QVariant& v) { edit->setText(v.toString()); }
+
+void VariantParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", edit->text());
+    w.writeEndElement();
+}
+
+void VariantParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        edit->setText(r.attributes().value("value").toString());
+    r.readNext();
+}
+
+FloatParam::FloatParam(QString name, float* p, float min, float max, float step, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = *p;
+    spin = pooled<UnitSpinBox>();
+    spin->setCanonicalRange(min, max);
+    spin->setCanonicalStep(step);
+    spin->setCanonicalValue(*p);
+    spin->setToolTip(tip);
+    spin->setAlignment(Qt::AlignRight);
+    widget = spin;
+}
+
+void FloatParam::apply() { *ptr = static_cast<float>(spin->canonicalValue()); }
+
+void FloatParam::reset() { spin->setCanonicalValue(defVal); }
+
+double FloatParam::minimum() const { return spin->canonicalMinimum(); }
+
+double FloatParam::maximum() const { return spin->canonicalMaximum(); }
+
+QVariant FloatParam::storedValue() const { return double(*ptr); }
+
+QVariant FloatParam::value() const { return spin->canonicalValue(); }
+
+void FloatParam::setValue(const QVariant& v) { spin->setCanonicalValue(v.toDouble()); }
+
+void FloatParam::setDisplayUnit(const UnitConversion& unit) { spin->setConversion(unit); }
+
+void FloatParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", QString::number(spin->canonicalValue(), 'f', 6));
+    w.writeEndElement();
+}
+
+void FloatParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        spin->setCanonicalValue(r.attributes().value("value").toFloat());
+    r.readNext();
+}
+
+SliderParam::SliderParam(QString name, double* p, double min, double max, double step, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    dptr = p;
+    init(name, *p, min, max, step, 2, tip);
+}
+
+SliderParam::SliderParam(QString name, int* p, int min, int max, int step, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    iptr = p;
+    init(name, *p, min, max, step, 0, tip);
+}
+
+void SliderParam::setMaxRate(double hz) { setGestureRate(hz); }
+
+void SliderParam::apply() {
+    if (dptr) *dptr = spin->canonicalValue();
+    else *iptr = qRound(spin->canonicalValue());
+}
+
+void SliderParam::reset() { spin->setCanonicalValue(defVal); }
+
+QVariant SliderParam::storedValue() const { return dptr ? QVariant(*dptr) : QVariant(*iptr); }
+
+QVariant SliderParam::value() const {
+    return dptr ? QVariant(spin->canonicalValue()) : QVariant(qRound(spin->canonicalValue()));
+}
+
+void SliderParam::setValue(const QVariant& v) { spin->setCanonicalValue(v.toDouble()); }
+
+void SliderParam::setDisplayUnit(const UnitConversion& unit) { spin->setConversion(unit); }
+
+void SliderParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("value", QString::number(spin->canonicalValue()));
+    w.writeEndElement();
+}
+
+void SliderParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("value"))
+        spin->setCanonicalValue(r.attributes().value("value").toDouble());
+    r.readNext();
+}
+
+void SliderParam::trackEdits() {
+    if (!beginTracking()) return;
+    // Connected after the synchronization made by init(): the other widget already shows the value
+    connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this]() { textEdited(spin); });
+    trackCommit(spin);
+    connect(slider, &QSlider::valueChanged, this, [this]() {
+        if (slider->isSliderDown()) throttledChanged();
+        else emit changed();
+        });
+    connect(slider, &QSlider::sliderReleased, this, &SliderParam::endGesture);
+}
+
+void SliderParam::init(const QString& name, double value, double min, double max, double step, int decimals, const QString& tip) {
+    this->name = name;
+    defVal = value;
+    minVal = min;
+    maxVal = max;
+
+    QWidget* container = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    slider = new QSlider(Qt::Horizontal);
+    const double steps = step > 0 ? (max - min) / step : 1000.0;
+    slider->setRange(0, int(qBound(1.0, std::round(steps), 100000.0)));
+    slider->setToolTip(tip);
+
+    spin = new UnitSpinBox;
+    spin->setDecimals(decimals);
+    spin->setCanonicalRange(min, max);
+    spin->setCanonicalStep(step);
+    spin->setCanonicalValue(value);
+    spin->setToolTip(tip);
+    spin->setAlignment(Qt::AlignRight);
+    slider->setValue(toSlider(spin->canonicalValue()));
+
+    layout->addWidget(slider, 1);
+    layout->addWidget(spin);
+    widget = container;
+
+    // Each widget follows the other, whether or not the edits are tracked
+    connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this]() {
+        QSignalBlocker block(slider);
+        slider->setValue(toSlider(spin->canonicalValue()));
+        });
+    connect(slider, &QSlider::valueChanged, this, [this](int pos) {
+        QSignalBlocker block(spin);
+        spin->setCanonicalValue(fromSlider(pos));
+        });
+}
+
+int SliderParam::toSlider(double v) const {
+    if (maxVal <= minVal) return 0;
+    return qRound((v - minVal) / (maxVal - minVal) * slider->maximum());
+}
+
+double SliderParam::fromSlider(int pos) const {
+    return minVal + (maxVal - minVal) * pos / slider->maximum();
+}
+
+/* -------------------------------------
+   Image Parameter and Thumbnail Cache
+   ------------------------------------- */
+
+ThumbnailCache::ThumbnailCache() {
+    cache.setMaxCost(16 * 1024); // 16 MiB of thumbnails
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+}
+
+ThumbnailCache* ThumbnailCache::instance() {
+    static ThumbnailCache* cache = nullptr;
+    static bool closed = false;
+    if (!cache && !closed && qApp) {
+        cache = new ThumbnailCache;
+        // Workers and their queued replies must end before the application object does
+        QObject::connect(qApp, &QCoreApplication::aboutToQuit, []() {
+            closed = true;
+            delete cache;
+            cache = nullptr;
+            });
+    }
+    return cache;
+}
+
+ThumbnailCache::~ThumbnailCache() {
+    pool.clear();
+    pool.waitForDone();
+}
+
+void ThumbnailCache::setMaxCost(int kib) { cache.setMaxCost(kib); }
+
+QImage ThumbnailCache::request(const QString& path, const QSize& size, QObject* receiver,
+    const std::function<void(const QImage&)>& ready) {
+    if (path.isEmpty()) return QImage();
+    const QString request = path + QLatin1Char('|') + QString::number(size.width())
+        + QLatin1Char('x') + QString::number(size.height());
+    const QString known = latestKey.value(request);
+    QImage* cached = known.isEmpty() ? nullptr : cache.object(known);
+    if (receiver && ready) {
+        QVector<Waiter>& waiters = waiting[request];
+        auto same = std::find_if(waiters.begin(), waiters.end(), [receiver](const Waiter& w) { return w.receiver == receiver; });
+        if (same != waiters.end()) same->ready = ready;
+        else waiters.append(Waiter{ receiver, ready });
+    }
+    if (!pending.contains(request))
+        schedule(request, path, size, cached ? known : QString());
+    return cached ? *cached : QImage();
+}
+
+void ThumbnailCache::schedule(const QString& request, const QString& path, const QSize& size, const QString& knownKey) {
+    pending.insert(request);
+    pool.start(QRunnable::create([this, request, path, size, knownKey]() {
+        const QFileInfo info(path);
+        const QString key = request + QLatin1Char('|')
+            + QString::number(info.lastModified().toMSecsSinceEpoch());
+        if (key == knownKey) {
+            QMetaObject::invokeMethod(this, [this, request, path, size]() {
+                onUnchanged(request, path, size);
+                }, Qt::QueuedConnection);
+            return;
+        }
+        QImage image;
+        if (info.isFile()) {
+            QImageReader reader(path);
+            reader.setAutoTransform(true);
+            const QSize full = reader.size();
+            if (full.isValid())
+                reader.setScaledSize(full.scaled(size, Qt::KeepAspectRatio));
+            image = reader.read();
+        }
+        QMetaObject::invokeMethod(this, [this, request, path, key, image]() {
+            onDecoded(request, path, key, image);
+            }, Qt::QueuedConnection);
+        }));
+}
+
+void ThumbnailCache::onDecoded(const QString& request, const QString& path, const QString& key, const QImage& image) {
+    pending.remove(request);
+    const QString old = latestKey.value(request);
+    if (!old.isEmpty() && old != key)
+        cache.remove(old);
+    latestKey.insert(request, key);
+    if (!image.isNull())
+        cache.insert(key, new QImage(image), qMax(1, int(image.sizeInBytes() / 1024)));
+    if (latestKey.size() > 2 * cache.count() + 64) {
+        // QCache evicts silently: forget the keys of thumbnails no longer held
+        for (auto it = latestKey.begin(); it != latestKey.end();) {
+            if (cache.contains(it.value()) || pending.contains(it.key())) ++it;
+            else it = latestKey.erase(it);
+        }
+    }
+    deliver(request, image);
+    emit thumbnailReady(path, image);
+}
+
+void ThumbnailCache::onUnchanged(const QString& request, const QString& path, const QSize& size) {
+    pending.remove(request);
+    if (!waiting.contains(request)) return;
+    const QString known = latestKey.value(request);
+    if (QImage* cached = known.isEmpty() ? nullptr : cache.object(known))
+        deliver(request, *cached);
+    else
+        schedule(request, path, size, QString());
+}
+
+void ThumbnailCache::deliver(const QString& request, const QImage& image) {
+    const QVector<Waiter> waiters = waiting.take(request);
+    for (const Waiter& w : waiters)
+        if (w.receiver) w.ready(image);
+}
+
+ImageParam::ImageParam(QString name, QString* p, QString def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    QWidget* container = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    thumb = new QLabel;
+    thumb->setFixedSize(thumbnailSize());
+    thumb->setAlignment(Qt::AlignCenter);
+    thumb->setFrameShape(QFrame::StyledPanel);
+    thumb->installEventFilter(this);
+
+    edit = new QLineEdit(*p);
+    edit->setToolTip(tip);
+
+    layout->addWidget(thumb);
+    layout->addWidget(edit);
+    widget = container;
+
+    connect(edit, &QLineEdit::editingFinished, this, &ImageParam::updateThumbnail);
+}
+
+QSize ImageParam::thumbnailSize() { return QSize(40, 24); }
+
+void ImageParam::apply() { *ptr = edit->text(); }
+
+void ImageParam::reset() {
+    edit->setText(defVal);
+    updateThumbnail();
+}
+
+QVariant ImageParam::storedValue() const { return *ptr; }
+
+QVariant ImageParam::value() const { return edit->text(); }
+
+void ImageParam::setValue(const QVariant& v) {
+    edit->setText(v.toString());
+    updateThumbnail();
+}
+
+void ImageParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("path", edit->text());
+    w.writeEndElement();
+}
+
+void ImageParam::load(QXmlStreamReader& r) {
+    if (r.attributes().hasAttribute("path")) {
+        edit->setText(r.attributes().value("path").toString());
+        updateThumbnail();
+    }
+    r.readNext();
+}
+
+bool ImageParam::eventFilter(QObject* o, QEvent* e) {
+    if (o == thumb && e->type() == QEvent::Show && thumbStale)
+        updateThumbnail();
+    return ParamBase::eventFilter(o, e);
+}
+
+void ImageParam::onBrowseClicked() {
+    QStringList patterns;
+    for (const QByteArray& fmt : QImageReader::supportedImageFormats())
+        patterns << "*." + QString::fromLatin1(fmt);
+    QString file = QFileDialog::getOpenFileName(widget, "Select Image", edit->text(),
+        QString("Images (%1);;All files (*)").arg(patterns.join(' ')));
+    if (!file.isEmpty()) {
+        edit->setText(file);
+        updateThumbnail();
+    }
+}
+
+void ImageParam::updateThumbnail() {
+    if (!thumb->isVisible()) {
+        thumbStale = true;
+        return;
+    }
+    thumbStale = false;
+    ThumbnailCache* cache = ThumbnailCache::instance();
+    if (!cache) return;
+    const QString path = edit->text();
+    setThumbnail(cache->request(path, thumbnailSize(), this, [this, path](const QImage& image) {
+        if (path == edit->text()) setThumbnail(image);
+        }));
+}
+
+void ImageParam::setThumbnail(const QImage& image) {
+    if (image.isNull()) {
+        thumb->clear();
+        return;
+    }
+    thumb->setPixmap(QPixmap::fromImage(image));
+}
+
+/* -------------------------------------
+   Curve and Lookup-table Parameters
+   ------------------------------------- */
+
+QString PackedFloats::encode(const float* data, int count) {
+    QByteArray raw(count * int(sizeof(float)), Qt::Uninitialized);
+    qToLittleEndian<float>(data, count, raw.data());
+    return QString::fromLatin1(qCompress(raw).toBase64());
+}
+
+QVector<float> PackedFloats::decode(const QStringRef& text, int maxCount) {
+    const QByteArray packed = QByteArray::fromBase64(text.toLatin1());
+    if (packed.size() < 4) return QVector<float>();
+    const quint32 expected = qFromBigEndian<quint32>(packed.constData());
+    if (expected % sizeof(float) || expected / sizeof(float) > quint32(maxCount)) return QVector<float>();
+    const QByteArray raw = qUncompress(packed);
+    if (raw.size() % int(sizeof(float))) return QVector<float>();
+    QVector<float> values(raw.size() / int(sizeof(float)));
+    qFromLittleEndian<float>(raw.constData(), values.size(), values.data());
+    return values;
+}
+
+CurveEditor::CurveEditor(QWidget* parent)
+    : QWidget(parent) {
+    setMinimumSize(120, 80);
+    setMouseTracking(false);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void CurveEditor::setPoints(const QVector<QPointF>& p) {
+    pts.clear();
+    // NaN would break the sort below; infinities are clamped like any other value
+    for (const QPointF& pt : p)
+        if (!std::isnan(pt.x()) && !std::isnan(pt.y()))
+            pts.append(QPointF(qBound(0.0, pt.x(), 1.0), qBound(0.0, pt.y(), 1.0)));
+    std::sort(pts.begin(), pts.end(), [](const QPointF& a, const QPointF& b) { return a.x() < b.x(); });
+    invalidateAll();
+}
+
+double CurveEditor::evaluate(const QVector<QPointF>& p, double x) {
+    if (p.isEmpty()) return x;
+    if (x <= p.first().x()) return p.first().y();
+    if (x >= p.last().x()) return p.last().y();
+    const auto it = std::upper_bound(p.begin(), p.end(), x,
+        [](double v, const QPointF& pt) { return v < pt.x(); });
+    return evaluateSegment(p, int(it - p.begin()) - 1, x);
+}
+
+QSize CurveEditor::sizeHint() const { return QSize(240, 150); }
+
+void CurveEditor::paintEvent(QPaintEvent* e) {
+    QPainter painter(this);
+    painter.fillRect(e->rect(), palette().base());
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    painter.setPen(QPen(palette().mid().color(), 0, Qt::DotLine));
+    for (int i = 1; i < 4; ++i) {
+        painter.drawLine(toWidget(QPointF(i / 4.0, 0)), toWidget(QPointF(i / 4.0, 1)));
+        painter.drawLine(toWidget(QPointF(0, i / 4.0)), toWidget(QPointF(1, i / 4.0)));
+    }
+
+    painter.setPen(QPen(palette().text().color(), 1.5));
+    for (int i = 0; i < segments.size(); ++i) {
+        if (segmentStale[i]) rebuildSegment(i);
+        if (segments[i].controlPointRect().adjusted(-2, -2, 2, 2).intersects(e->rect()))
+            painter.drawPath(segments[i]);
+    }
+
+    painter.setPen(palette().text().color());
+    for (int i = 0; i < pts.size(); ++i) {
+        painter.setBrush(i == dragIndex ? palette().highlight() : palette().base());
+        painter.drawEllipse(toWidget(pts[i]), HandleRadius, HandleRadius);
+    }
+}
+
+void CurveEditor::resizeEvent(QResizeEvent* e) {
+    invalidateAll();
+    QWidget::resizeEvent(e);
+}
+
+void CurveEditor::mousePressEvent(QMouseEvent* e) {
+    const int hit = pointAt(e->pos());
+    if (e->button() == Qt::RightButton) {
+        if (hit >= 0 && pts.size() > 2) {
+            pts.remove(hit);
+            invalidateAll();
+            emit pointsEdited();
+        }
+        return;
+    }
+    if (e->button() != Qt::LeftButton) return;
+    if (hit >= 0) {
+        dragIndex = hit;
+    }
+    else {
+        const QPointF p = fromWidget(e->pos());
+        const auto it = std::upper_bound(pts.begin(), pts.end(), p.x(),
+            [](double v, const QPointF& pt) { return v < pt.x(); });
+        dragIndex = int(it - pts.begin());
+        pts.insert(dragIndex, p);
+        invalidateAll();
+        emit pointsEdited();
+    }
+    update(handleRect(dragIndex));
+}
+
+void CurveEditor::mouseMoveEvent(QMouseEvent* e) {
+    if (dragIndex < 0) return;
+    const double eps = 1e-4;
+    QPointF p = fromWidget(e->pos());
+    const double lo = dragIndex > 0 ? pts[dragIndex - 1].x() + eps : 0.0;
+    const double hi = dragIndex + 1 < pts.size() ? pts[dragIndex + 1].x() - eps : 1.0;
+    p.setX(qBound(lo, p.x(), qMax(lo, hi)));
+    if (p == pts[dragIndex]) return;
+
+    // Segments dragIndex-2 .. dragIndex+1 use the moved point
+    const int first = qMax(0, dragIndex - 2);
+    const int last = qMin(segments.size() - 1, dragIndex + 1);
+    QRectF dirty = handleRect(dragIndex);
+    for (int i = first; i <= last; ++i) {
+        if (segmentStale[i]) rebuildSegment(i);
+        dirty |= segments[i].controlPointRect();
+    }
+    pts[dragIndex] = p;
+    for (int i = first; i <= last; ++i) {
+        rebuildSegment(i);
+        dirty |= segments[i].controlPointRect();
+    }
+    dirty |= handleRect(dragIndex);
+    update(dirty.toAlignedRect().adjusted(-2, -2, 2, 2));
+    emit pointsEdited();
+}
+
+void CurveEditor::mouseReleaseEvent(QMouseEvent* e) {
+    if (e->button() != Qt::LeftButton || dragIndex < 0) return;
+    const QRectF r = handleRect(dragIndex);
+    dragIndex = -1;
+    update(r.toAlignedRect());
+}
+
+double CurveEditor::evaluateSegment(const QVector<QPointF>& p, int i, double x) {
+    const QPointF& a = p[i];
+    const QPointF& b = p[i + 1];
+    const double h = b.x() - a.x();
+    if (h <= 0) return a.y();
+    const double t = (x - a.x()) / h;
+    const double m0 = tangent(p, i) * h;
+    const double m1 = tangent(p, i + 1) * h;
+    const double t2 = t * t, t3 = t2 * t;
+    const double y = (2 * t3 - 3 * t2 + 1) * a.y() + (t3 - 2 * t2 + t) * m0
+        + (-2 * t3 + 3 * t2) * b.y() + (t3 - t2) * m1;
+    return qBound(0.0, y, 1.0);
+}
+
+double CurveEditor::tangent(const QVector<QPointF>& p, int i) {
+    const int a = qMax(0, i - 1);
+    const int b = qMin(p.size() - 1, i + 1);
+    const double dx = p[b].x() - p[a].x();
+    return dx > 0 ? (p[b].y() - p[a].y()) / dx : 0.0;
+}
+
+QRectF CurveEditor::plotRect() const {
+    return QRectF(rect()).adjusted(HandleRadius + 1, HandleRadius + 1, -HandleRadius - 1, -HandleRadius - 1);
+}
+
+QPointF CurveEditor::toWidget(const QPointF& p) const {
+    const QRectF r = plotRect();
+    return QPointF(r.left() + p.x() * r.width(), r.bottom() - p.y() * r.height());
+}
+
+QPointF CurveEditor::fromWidget(const QPointF& p) const {
+    const QRectF r = plotRect();
+    return QPointF(qBound(0.0, (p.x() - r.left()) / r.width(), 1.0),
+        qBound(0.0, (r.bottom() - p.y()) / r.height(), 1.0));
+}
+
+QRectF CurveEditor::handleRect(int i) const {
+    const QPointF c = toWidget(pts[i]);
+    const double r = HandleRadius + 2;
+    return QRectF(c.x() - r, c.y() - r, 2 * r, 2 * r);
+}
+
+int CurveEditor::pointAt(const QPoint& pos) const {
+    for (int i = 0; i < pts.size(); ++i)
+        if (QLineF(toWidget(pts[i]), pos).length() <= HandleRadius + 2)
+            return i;
+    return -1;
+}
+
+void CurveEditor::invalidateAll() {
+    const int n = qMax(0, pts.size() - 1);
+    segments.resize(n);
+    segmentStale.fill(true, n);
+    update();
+}
+
+void CurveEditor::rebuildSegment(int i) {
+    const QPointF a = toWidget(pts[i]);
+    const QPointF b = toWidget(pts[i + 1]);
+    const int steps = qMax(2, int((b.x() - a.x()) / 2));
+    QPainterPath path(a);
+    for (int s = 1; s <= steps; ++s) {
+        const double x = pts[i].x() + (pts[i + 1].x() - pts[i].x()) * s / steps;
+        path.lineTo(toWidget(QPointF(x, evaluateSegment(pts, i, x))));
+    }
+    segments[i] = path;
+    segmentStale[i] = false;
+}
+
+CurveParam::CurveParam(QString name, QVector<QPointF>* p, QVector<QPointF> def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+    editor = new CurveEditor(this);
+    editor->setPoints(*p);
+    editor->setToolTip(tip);
+    widget = editor;
+}
+
+void CurveParam::apply() { *ptr = editor->points(); }
+
+void CurveParam::reset() { editor->setPoints(defVal); }
+
+QVariant CurveParam::storedValue() const { return QPolygonF(*ptr); }
+
+QVariant CurveParam::value() const { return QPolygonF(editor->points()); }
+
+void CurveParam::setValue(const QVariant& v) { editor->setPoints(v.value<QPolygonF>()); }
+
+void CurveParam::save(QXmlStreamWriter& w) const {
+    QVector<float> xy;
+    xy.reserve(editor->points().size() * 2);
+    for (const QPointF& p : editor->points())
+        xy << float(p.x()) << float(p.y());
+    w.writeStartElement(name);
+    w.writeAttribute("points", PackedFloats::encode(xy.constData(), xy.size()));
+    w.writeEndElement();
+}
+
+void CurveParam::load(QXmlStreamReader& r) {
+    const QVector<float> xy = PackedFloats::decode(r.attributes().value("points"), 2 * MaxPoints);
+    if (xy.size() >= 4 && xy.size() % 2 == 0) {
+        QVector<QPointF> p;
+        for (int i = 0; i < xy.size(); i += 2)
+            p.append(QPointF(xy[i], xy[i + 1]));
+        editor->setPoints(p);
+    }
+    r.readNext();
+}
+
+void CurveParam::trackEdits() {
+    if (!beginTracking()) return;
+    connect(editor, &CurveEditor::pointsEdited, this, &ParamBase::changed);
+}
+
+LutEditor::LutEditor(float min, float max, QWidget* parent)
+    : QWidget(parent), lo(min), hi(max) {
+    setMinimumSize(80, 80);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void LutEditor::setTable(int width, int height, const QVector<float>& values) {
+    cols = width;
+    rows = height;
+    cells = values;
+    cells.resize(cols * rows);
+    // Files, the clipboard and setValue() may hold NaN or infinities: renderCells() must only see [lo, hi]
+    const float* src = cells.constData();
+    const int count = cells.size();
+    int i = 0;
+    while (i < count && src[i] >= lo && src[i] <= hi) ++i;
+    if (i < count) {
+        float* dst = cells.data();
+        for (; i < count; ++i)
+            dst[i] = std::isnan(dst[i]) ? lo : qBound(lo, dst[i], hi);
+    }
+    image = QImage(cols, rows, QImage::Format_Indexed8);
+    QVector<QRgb> colors(256);
+    for (int i = 0; i < 256; ++i)
+        colors[i] = QColor::fromHsvF((255 - i) / 255.0 * 2.0 / 3.0, 0.8, 0.95).rgb();
+    image.setColorTable(colors);
+    renderCells(QRect(0, 0, cols, rows));
+    update();
+}
+
+void LutEditor::setBrushRadius(int radius) { brushRadius = qMax(1, radius); }
+
+void LutEditor::setBrushStrength(double strength) { brushStrength = float(strength); }
+
+QSize LutEditor::sizeHint() const { return QSize(200, 150); }
+
+void LutEditor::paintEvent(QPaintEvent* e) {
+    QPainter painter(this);
+    if (image.isNull() || width() <= 0 || height() <= 0) {
+        painter.fillRect(e->rect(), palette().base());
+        return;
+    }
+    const double sx = double(cols) / width();
+    const double sy = double(rows) / height();
+    const QRect exposed = e->rect();
+    const int c0 = qBound(0, int(std::floor(exposed.left() * sx)), cols - 1);
+    const int r0 = qBound(0, int(std::floor(exposed.top() * sy)), rows - 1);
+    const int c1 = qBound(c0 + 1, int(std::ceil((exposed.right() + 1) * sx)), cols);
+    const int r1 = qBound(r0 + 1, int(std::ceil((exposed.bottom() + 1) * sy)), rows);
+    const QRectF source(c0, r0, c1 - c0, r1 - r0);
+    const QRectF target(c0 / sx, r0 / sy, (c1 - c0) / sx, (r1 - r0) / sy);
+    painter.drawImage(target, image, source);
+}
+
+void LutEditor::mousePressEvent(QMouseEvent* e) {
+    if (e->button() != Qt::LeftButton && e->button() != Qt::RightButton) return;
+    lastCell = toCell(e->pos());
+    stroke(lastCell, e->button() == Qt::RightButton);
+}
+
+void LutEditor::mouseReleaseEvent(QMouseEvent* e) {
+    if (e->button() == Qt::LeftButton || e->button() == Qt::RightButton)
+        emit strokeFinished();
+}
+
+void LutEditor::mouseMoveEvent(QMouseEvent* e) {
+    if (!(e->buttons() & (Qt::LeftButton | Qt::RightButton))) return;
+    const QPoint cell = toCell(e->pos());
+    if (cell == lastCell) return;
+    lastCell = cell;
+    stroke(cell, !(e->buttons() & Qt::LeftButton));
+}
+
+QPoint LutEditor::toCell(const QPoint& pos) const {
+    return QPoint(qBound(0, pos.x() * cols / qMax(1, width()), cols - 1),
+        qBound(0, pos.y() * rows / qMax(1, height()), rows - 1));
+}
+
+void LutEditor::stroke(const QPoint& centre, bool lower) {
+    if (cells.isEmpty()) return;
+    const QRect area = QRect(centre.x() - brushRadius, centre.y() - brushRadius,
+        2 * brushRadius + 1, 2 * brushRadius + 1) & QRect(0, 0, cols, rows);
+    const float amount = (lower ? -brushStrength : brushStrength) * (hi - lo);
+    const float sigma2 = 2.0f * (brushRadius / 2.0f) * (brushRadius / 2.0f);
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        float* row = cells.data() + y * cols;
+        for (int x = area.left(); x <= area.right(); ++x) {
+            const float dx = float(x - centre.x()), dy = float(y - centre.y());
+            const float d2 = dx * dx + dy * dy;
+            if (d2 > float(brushRadius * brushRadius)) continue;
+            row[x] = qBound(lo, row[x] + amount * std::exp(-d2 / sigma2), hi);
+        }
+    }
+    renderCells(area);
+    const double sx = double(width()) / cols;
+    const double sy = double(height()) / rows;
+    update(QRectF(area.left() * sx, area.top() * sy, area.width() * sx, area.height() * sy)
+        .toAlignedRect().adjusted(-1, -1, 1, 1));
+    emit tableEdited();
+}
+
+void LutEditor::renderCells(const QRect& area) {
+    const float scale = hi > lo ? 255.0f / (hi - lo) : 0.0f;
+    for (int y = area.top(); y <= area.bottom(); ++y) {
+        const float* src = cells.constData() + y * cols;
+        uchar* dst = image.scanLine(y);
+        for (int x = area.left(); x <= area.right(); ++x)
+            dst[x] = uchar(qBound(0, int((src[x] - lo) * scale + 0.5f), 255));
+    }
+}
+
+LutParam::LutParam(QString name, QVector<float>* p, int width, int height, float min, float max, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    static const bool registered = []() {
+        // Compared by QVariant (shared vectors compare at once) and streamed to the clipboard and QSettings
+        QMetaType::registerComparators<QVector<float>>();
+        qRegisterMetaTypeStreamOperators<QVector<float>>("QVector<float>");
+        return true;
+    }();
+    Q_UNUSED(registered);
+    this->name = name;
+    ptr = p;
+    cols = qBound(1, width, 1024);
+    rows = qBound(1, height, 1024);
+    if (p->size() != cols * rows)
+        p->resize(cols * rows);
+    defVal = *p;
+
+    QWidget* container = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    editor = new LutEditor(min, max);
+    editor->setTable(cols, rows, *p);
+    editor->setToolTip(tip);
+
+    QSpinBox* radius = new QSpinBox;
+    radius->setRange(1, qMax(cols, rows) / 2);
+    radius->setValue(qMin(8, radius->maximum()));
+    radius->setPrefix("r ");
+    radius->setToolTip("Brush radius in cells");
+    editor->setBrushRadius(radius->value());
+
+    QDoubleSpinBox* strength = new QDoubleSpinBox;
+    strength->setRange(0.001, 1.0);
+    strength->setDecimals(3);
+    strength->setSingleStep(0.01);
+    strength->setValue(0.05);
+    strength->setToolTip("Brush strength (left button raises, right button lowers)");
+
+    QVBoxLayout* tools = new QVBoxLayout;
+    tools->addWidget(radius);
+    tools->addWidget(strength);
+    tools->addStretch();
+
+    layout->addWidget(editor, 1);
+    layout->addLayout(tools);
+    widget = container;
+
+    connect(radius, QOverload<int>::of(&QSpinBox::valueChanged), editor, &LutEditor::setBrushRadius);
+    connect(strength, QOverload<double>::of(&QDoubleSpinBox::valueChanged), editor, &LutEditor::setBrushStrength);
+}
+
+void LutParam::apply() { *ptr = editor->values(); }
+
+void LutParam::reset() { editor->setTable(cols, rows, defVal); }
+
+QVariant LutParam::storedValue() const { return QVariant::fromValue(*ptr); }
+
+QVariant LutParam::value() const { return QVariant::fromValue(editor->values()); }
+
+void LutParam::setValue(const QVariant& v) {
+    if (v.userType() == qMetaTypeId<QVector<float>>()) {
+        const QVector<float> values = v.value<QVector<float>>();
+        if (values.size() == cols * rows)
+            editor->setTable(cols, rows, values);
+        return;
+    }
+    const QByteArray raw = v.toByteArray();
+    if (raw.size() != cols * rows * int(sizeof(float))) return;
+    QVector<float> values(cols * rows);
+    memcpy(values.data(), raw.constData(), size_t(raw.size()));
+    editor->setTable(cols, rows, values);
+}
+
+void LutParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    w.writeAttribute("width", QString::number(cols));
+    w.writeAttribute("height", QString::number(rows));
+    w.writeAttribute("data", PackedFloats::encode(editor->values().constData(), cols * rows));
+    w.writeEndElement();
+}
+
+void LutParam::load(QXmlStreamReader& r) {
+    const QXmlStreamAttributes a = r.attributes();
+    if (a.value("width").toInt() == cols && a.value("height").toInt() == rows) {
+        const QVector<float> values = PackedFloats::decode(a.value("data"), cols * rows);
+        if (values.size() == cols * rows)
+            editor->setTable(cols, rows, values);
+    }
+    r.readNext();
+}
+
+void LutParam::trackEdits() {
+    if (!beginTracking()) return;
+    connect(editor, &LutEditor::tableEdited, this, &LutParam::throttledChanged);
+    connect(editor, &LutEditor::strokeFinished, this, &LutParam::endGesture);
+}
+
+/* -------------------------------------
+   Parameter Group Templates
+   ------------------------------------- */
+
+int ParamGroupTemplate::addField(const QString& key, const QString& label,
+    double min, double max, double step, double def, const QString& tip) {
+    fields.append(Field{ key, label, tip, min, max, step, qBound(min, def, max) });
+    return fields.size() - 1;
+}
+
+int ParamGroupTemplate::indexOf(const QString& key) const {
+    for (int i = 0; i < fields.size(); ++i)
+        if (fields.at(i).key == key) return i;
+    return -1;
+}
+
+QVector<double> ParamGroupTemplate::defaults() const {
+    QVector<double> values(fields.size());
+    for (int i = 0; i < fields.size(); ++i)
+        values[i] = fields.at(i).def;
+    return values;
+}
+
+GroupParam::GroupParam(QString name, const ParamGroupTemplate& t, QVector<double>* p, QWidget* parent)
+    : ParamBase(parent), tmpl(t) {
+    this->name = name;
+    ptr = p;
+    shown = tmpl.defaults();
+    const int n = qMin(shown.size(), p->size());
+    for (int i = 0; i < n; ++i)
+        shown[i] = qBound(tmpl.field(i).min, p->at(i), tmpl.field(i).max);
+}
+
+void GroupParam::apply() { *ptr = shown; }
+
+void GroupParam::reset() {
+    for (int i = 0; i < tmpl.fieldCount(); ++i)
+        setField(i, tmpl.field(i).def);
+}
+
+QVariant GroupParam::storedValue() const {
+    QVariantList values;
+    for (int i = 0; i < tmpl.fieldCount(); ++i)
+        values.append(ptr->value(i, tmpl.field(i).def));
+    return values;
+}
+
+QVariant GroupParam::value() const {
+    QVariantList values;
+    for (double v : shown) values.append(v);
+    return values;
+}
+
+void GroupParam::setValue(const QVariant& v) {
+    const QVariantList values = v.toList();
+    if (values.size() != tmpl.fieldCount()) return;
+    for (int i = 0; i < values.size(); ++i)
+        setField(i, values.at(i).toDouble());
+}
+
+void GroupParam::save(QXmlStreamWriter& w) const {
+    w.writeStartElement(name);
+    for (int i = 0; i < tmpl.fieldCount(); ++i)
+        w.writeAttribute(tmpl.field(i).key, QString::number(shown.at(i)));
+    w.writeEndElement();
+}
+
+void GroupParam::load(QXmlStreamReader& r) {
+    const QXmlStreamAttributes attributes = r.attributes();
+    for (int i = 0; i < tmpl.fieldCount(); ++i) {
+        if (attributes.hasAttribute(tmpl.field(i).key))
+            setField(i, attributes.value(tmpl.field(i).key).toDouble());
+    }
+    r.readNext();
+}
+
+void GroupParam::createWidget() {
+    if (editor) return;
+    editor = new CompoundEditor(tmpl.decimals(), this);
+    for (int i = 0; i < tmpl.fieldCount(); ++i) {
+        const ParamGroupTemplate::Field& f = tmpl.field(i);
+        editor->addField(f.label, f.min, f.max, f.step, f.tip);
+        editor->setValue(i, shown.at(i));
+    }
+    connect(editor, &CompoundEditor::valueChanged, this, [this](int i) {
+        shown[i] = editor->value(i);
+        emit changed();
+    });
+    widget = editor;
+}
+
+void GroupParam::setField(int i, double v) {
+    if (editor) {
+        editor->setValue(i, v); // valueChanged() updates shown
+        return;
+    }
+    const ParamGroupTemplate::Field& f = tmpl.field(i);
+    v = qBound(f.min, v, f.max);
+    if (v == shown.at(i)) return;
+    shown[i] = v;
+    emit changed();
+}
+
+/* -------------------------------------
+   Record Table Parameter
+   ------------------------------------- */
+
+RecordColumn RecordColumn::boolColumn(const QString& key, const QString& title, const QString& tip) {
+    RecordColumn c;
+    c.type = Bool;
+    c.key = key;
+    c.title = title;
+    c.tip = tip;
+    return c;
+}
+
+RecordColumn RecordColumn::intColumn(const QString& key, const QString& title, int min, int max, const QString& tip) {
+    RecordColumn c;
+    c.type = Int;
+    c.key = key;
+    c.title = title;
+    c.tip = tip;
+    c.min = min;
+    c.max = max;
+    return c;
+}
+
+RecordColumn RecordColumn::doubleColumn(const QString& key, const QString& title,
+    double min, double max, double step, int decimals, const QString& tip) {
+    RecordColumn c;
+    c.type = Double;
+    c.key = key;
+    c.title = title;
+    c.tip = tip;
+    c.min = min;
+    c.max = max;
+    c.step = step;
+    c.decimals = decimals;
+    return c;
+}
+
+RecordColumn RecordColumn::stringColumn(const QString& key, const QString& title, const QString& tip) {
+    RecordColumn c;
+    c.key = key;
+    c.title = title;
+    c.tip = tip;
+    return c;
+}
+
+RecordColumn RecordColumn::choiceColumn(const QString& key, const QString& title, const QStringList& options, const QString& tip) {
+    RecordColumn c;
+    c.type = Choice;
+    c.key = key;
+    c.title = title;
+    c.tip = tip;
+    c.options = options;
+    return c;
+}
+
+QVariant RecordColumn::defaultValue() const {
+    switch (type) {
+    case Bool: return false;
+    case Int: return int(qBound(min, 0.0, max));
+    case Double: return qBound(min, 0.0, max);
+    case Choice: return 0;
+    default: return QString();
+    }
+}
+
+QVariant RecordColumn::coerce(const QVariant& v) const {
+    switch (type) {
+    case Bool: return v.toBool();
+    case Int: return int(qBound(min, double(v.toInt()), max));
+    case Double: return qBound(min, v.toDouble(), max);
+    case Choice: return qBound(0, v.toInt(), qMax(0, options.size() - 1));
+    default: return v.toString();
+    }
+}
+
+/**
+ * @brief Format a cell for a saved file, before escaping.
+ */
+static QString recordCellText(const RecordColumn& c, const QVariant& v) {
+    switch (c.type) {
+    case RecordColumn::Bool: return v.toBool() ? "1" : "0";
+    case RecordColumn::Int: return QString::number(v.toInt());
+    case RecordColumn::Double: return QString::number(v.toDouble(), 'g', QLocale::FloatingPointShortest);
+    case RecordColumn::Choice: return c.options.value(v.toInt());
+    default: return v.toString();
+    }
+}
+
+/**
+ * @brief Parse a cell read from a saved file, after unescaping.
+ */
+static QVariant recordCellValue(const RecordColumn& c, const QString& text) {
+    switch (c.type) {
+    case RecordColumn::Bool: return text == "1";
+    case RecordColumn::Int: return c.coerce(text.toInt());
+    case RecordColumn::Double: return c.coerce(text.toDouble());
+    case RecordColumn::Choice: return c.options.contains(text) ? QVariant(c.options.indexOf(text)) : c.defaultValue();
+    default: return text;
+    }
+}
+
+RecordTableModel::RecordTableModel(const QVector<RecordColumn>& c, QObject* parent)
+    : QAbstractTableModel(parent), columns(c) {}
+
+void RecordTableModel::setValues(const QVector<QVariant>& values) {
+    const int n = columns.size();
+    QVector<QVariant> next = n > 0 ? values.mid(0, values.size() / n * n) : QVector<QVariant>();
+    for (int i = 0; i < next.size(); ++i)
+        next[i] = columns.at(i % n).coerce(next.at(i));
+    if (next == cells) return;
+    beginResetModel();
+    cells = next;
+    endResetModel();
+    emit edited();
+}
+
+int RecordTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || columns.isEmpty()) return 0;
+    return cells.size() / columns.size();
+}
+
+int RecordTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : columns.size();
+}
+
+QVariant RecordTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+    const RecordColumn& c = columns.at(index.column());
+    const QVariant& v = cells.at(index.row() * columns.size() + index.column());
+    switch (role) {
+    case Qt::DisplayRole:
+        if (c.type == RecordColumn::Bool) return QVariant();
+        if (c.type == RecordColumn::Double) return QString::number(v.toDouble(), 'f', c.decimals);
+        if (c.type == RecordColumn::Choice) return c.options.value(v.toInt());
+        return v;
+    case Qt::EditRole:
+        return v;
+    case Qt::CheckStateRole:
+        if (c.type == RecordColumn::Bool) return int(v.toBool() ? Qt::Checked : Qt::Unchecked);
+        return QVariant();
+    case Qt::ToolTipRole:
+        return c.tip;
+    case Qt::TextAlignmentRole:
+        if (c.type == RecordColumn::Int || c.type == RecordColumn::Double)
+            return int(Qt::AlignRight | Qt::AlignVCenter);
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+bool RecordTableModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid()) return false;
+    const RecordColumn& c = columns.at(index.column());
+    QVariant v;
+    if (c.type == RecordColumn::Bool && role == Qt::CheckStateRole)
+        v = value.toInt() == Qt::Checked;
+    else if (c.type != RecordColumn::Bool && role == Qt::EditRole)
+        v = c.coerce(value);
+    else
+        return false;
+    QVariant& cell = cells[index.row() * columns.size() + index.column()];
+    if (cell == v) return true;
+    cell = v;
+    emit dataChanged(index, index);
+    emit edited();
+    return true;
+}
+
+QVariant RecordTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation == Qt::Vertical)
+        return role == Qt::DisplayRole ? QVariant(section + 1) : QVariant();
+    if (role == Qt::DisplayRole) return columns.at(section).title;
+    if (role == Qt::ToolTipRole) return columns.at(section).tip;
+    return QVariant();
+}
+
+Qt::ItemFlags RecordTableModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    Qt::ItemFlags f = Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren;
+    return f | (columns.at(index.column()).type == RecordColumn::Bool ? Qt::ItemIsUserCheckable : Qt::ItemIsEditable);
+}
+
+bool RecordTableModel::insertRows(int row, int count, const QModelIndex& parent) {
+    const int n = columns.size();
+    if (parent.isValid() || n == 0 || count < 1 || row < 0 || row > rowCount()) return false;
+    beginInsertRows(parent, row, row + count - 1);
+    cells.insert(row * n, count * n, QVariant());
+    for (int i = row * n; i < (row + count) * n; ++i)
+        cells[i] = columns.at(i % n).defaultValue();
+    endInsertRows();
+    emit edited();
+    return true;
+}
+
+bool RecordTableModel::removeRows(int row, int count, const QModelIndex& parent) {
+    const int n = columns.size();
+    if (parent.isValid() || count < 1 || row < 0 || row + count > rowCount()) return false;
+    beginRemoveRows(parent, row, row + count - 1);
+    cells.remove(row * n, count * n);
+    endRemoveRows();
+    emit edited();
+    return true;
+}
+
+bool RecordTableModel::moveRows(const QModelIndex& sourceParent, int sourceRow, int count,
+    const QModelIndex& destinationParent, int destinationChild) {
+    const int n = columns.size();
+    if (sourceParent.isValid() || destinationParent.isValid() || count < 1
+        || sourceRow < 0 || sourceRow + count > rowCount()
+        || destinationChild < 0 || destinationChild > rowCount()
+        || (destinationChild >= sourceRow && destinationChild <= sourceRow + count))
+        return false;
+    if (!beginMoveRows(sourceParent, sourceRow, sourceRow + count - 1, destinationParent, destinationChild))
+        return false;
+    // Rotate the cells in place: the moved block and the rows it passes swap places
+    QVariant* first = cells.data();
+    if (destinationChild > sourceRow)
+        std::rotate(first + sourceRow * n, first + (sourceRow + count) * n, first + destinationChild * n);
+    else
+        std::rotate(first + destinationChild * n, first + sourceRow * n, first + (sourceRow + count) * n);
+    endMoveRows();
+    emit edited();
+    return true;
+}
+
+RecordColumnDelegate::RecordColumnDelegate(const RecordColumn& c, QObject* parent)
+    : QStyledItemDelegate(parent), column(c) {}
+
+QWidget* RecordColumnDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    switch (column.type) {
+    case RecordColumn::Bool:
+        return nullptr;
+    case RecordColumn::Int: {
+        CompactSpinBox* spin = new CompactSpinBox(parent);
+        spin->setFrame(false);
+        spin->setRange(int(column.min), int(column.max));
+        spin->setSingleStep(qMax(1, int(column.step)));
+        return spin;
+    }
+    case RecordColumn::Double: {
+        CompactDoubleSpinBox* spin = new CompactDoubleSpinBox(parent);
+        spin->setFrame(false);
+        spin->setDecimals(column.decimals);
+        spin->setRange(column.min, column.max);
+        spin->setSingleStep(column.step);
+        return spin;
+    }
+    case RecordColumn::Choice: {
+        QComboBox* combo = new QComboBox(parent);
+        combo->setFrame(false);
+        combo->addItems(column.options);
+        return combo;
+    }
+    default:
+        return QStyledItemDelegate::createEditor(parent, option, index);
+    }
+}
+
+void RecordColumnDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const {
+    const QVariant v = index.data(Qt::EditRole);
+    if (QSpinBox* spin = qobject_cast<QSpinBox*>(editor))
+        spin->setValue(v.toInt());
+    else if (QDoubleSpinBox* dspin = qobject_cast<QDoubleSpinBox*>(editor))
+        dspin->setValue(v.toDouble());
+    else if (QComboBox* combo = qobject_cast<QComboBox*>(editor))
+        combo->setCurrentIndex(v.toInt());
+    else
+        QStyledItemDelegate::setEditorData(editor, index);
+}
+
+void RecordColumnDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const {
+    if (QSpinBox* spin = qobject_cast<QSpinBox*>(editor)) {
+        spin->interpretText();
+        model->setData(index, spin->value());
+    }
+    else if (QDoubleSpinBox* dspin = qobject_cast<QDoubleSpinBox*>(editor)) {
+        dspin->interpretText();
+        model->setData(index, dspin->value());
+    }
+    else if (QComboBox* combo = qobject_cast<QComboBox*>(editor))
+        model->setData(index, combo->currentIndex());
+    else
+        QStyledItemDelegate::setModelData(editor, model, index);
+}
+
+RecordTableParam::RecordTableParam(QString name, QVector<QVariant>* p, const QVector<RecordColumn>& columns,
+    QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+
+    model = new RecordTableModel(columns, this);
+    model->setValues(*p);
+    defVal = model->values();
+
+    QWidget* container = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+
+    view = new QTableView;
+    view->setModel(model);
+    for (int c = 0; c < columns.size(); ++c)
+        view->setItemDelegateForColumn(c, new RecordColumnDelegate(columns.at(c), view));
+    // Fixed row heights: the view never measures rows outside the viewport
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->verticalHeader()->setDefaultSectionSize(view->fontMetrics().height() + 6);
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed | QAbstractItemView::AnyKeyPressed);
+    view->setWordWrap(false);
+    view->setToolTip(tip);
+
+    QToolButton* addButton = new QToolButton;
+    addButton->setText("+");
+    addButton->setToolTip("Insert a row after the current one");
+    QToolButton* removeButton = new QToolButton;
+    removeButton->setText("-");
+    removeButton->setToolTip("Delete the selected rows");
+    QToolButton* upButton = new QToolButton;
+    upButton->setArrowType(Qt::UpArrow);
+    upButton->setToolTip("Move the current row up");
+    QToolButton* downButton = new QToolButton;
+    downButton->setArrowType(Qt::DownArrow);
+    downButton->setToolTip("Move the current row down");
+
+    QVBoxLayout* tools = new QVBoxLayout;
+    tools->addWidget(addButton);
+    tools->addWidget(removeButton);
+    tools->addWidget(upButton);
+    tools->addWidget(downButton);
+    tools->addStretch();
+
+    layout->addWidget(view, 1);
+    layout->addLayout(tools);
+    widget = container;
+
+    connect(addButton, &QToolButton::clicked, this, [this]() {
+        const QModelIndex current = view->currentIndex();
+        const int row = current.isValid() ? current.row() + 1 : model->rowCount();
+        if (model->insertRow(row))
+            view->setCurrentIndex(model->index(row, 0));
+    });
+    connect(removeButton, &QToolButton::clicked, this, [this]() {
+        QList<int> rows;
+        for (const QModelIndex& index : view->selectionModel()->selectedRows())
+            rows.append(index.row());
+        std::sort(rows.begin(), rows.end());
+        // Remove contiguous runs from the bottom, so the rows above keep their index
+        for (int end = rows.size(); end > 0;) {
+            int begin = end - 1;
+            while (begin > 0 && rows.at(begin - 1) == rows.at(begin) - 1) --begin;
+            model->removeRows(rows.at(begin), end - begin);
+            end = begin;
+        }
+    });
+    connect(upButton, &QToolButton::clicked, this, [this]() { moveCurrent(-1); });
+    connect(downButton, &QToolButton::clicked, this, [this]() { moveCurrent(1); });
+}
+
+void RecordTableParam::apply() { *ptr = model->values(); }
+
+void RecordTableParam::reset() { model->setValues(defVal); }
+
+QVariant RecordTableParam::storedValue() const { return QVariant(ptr->toList()); }
+
+QVariant RecordTableParam::value() const { return QVariant(model->values().toList()); }
+
+void RecordTableParam::setValue(const QVariant& v) {
+    model->setValues(QVector<QVariant>::fromList(v.toList()));
+}
+
+void RecordTableParam::save(QXmlStreamWriter& w) const {
+    const int n = model->columnCount();
+    QStringList keys;
+    for (int c = 0; c < n; ++c)
+        keys.append(model->column(c).key);
+    const QVector<QVariant>& cells = model->values();
+    QString data;
+    for (int i = 0; i < cells.size(); ++i) {
+        const int c = i % n;
+        if (c > 0) data += ',';
+        data += escaped(recordCellText(model->column(c), cells.at(i)));
+        if (c == n - 1) data += ';';
+    }
+    w.writeStartElement(name);
+    w.writeAttribute("columns", keys.join(','));
+    w.writeAttribute("data", data);
+    w.writeEndElement();
+}
+
+void RecordTableParam::load(QXmlStreamReader& r) {
+    const QXmlStreamAttributes a = r.attributes();
+    const int n = model->columnCount();
+    if (n > 0 && a.hasAttribute("data")) {
+        // Saved column -> current column, -1 for columns that no longer exist
+        const QStringList keys = a.value("columns").toString().split(',');
+        QVector<int> target(keys.size(), -1);
+        QVector<QVariant> defaults(n);
+        for (int c = 0; c < n; ++c) {
+            defaults[c] = model->column(c).defaultValue();
+            const int saved = keys.indexOf(model->column(c).key);
+            if (saved >= 0) target[saved] = c;
+        }
+
+        const QStringRef data = a.value("data");
+        QVector<QVariant> cells;
+        QVector<QVariant> row = defaults;
+        QString field;
+        int saved = 0;
+        auto endField = [&]() {
+            if (saved < target.size() && target.at(saved) >= 0)
+                row[target.at(saved)] = recordCellValue(model->column(target.at(saved)), field);
+            ++saved;
+            field.clear();
+        };
+        for (int i = 0; i < data.size() && cells.size() < MaxRows * n; ++i) {
+            const QChar ch = data.at(i);
+            if (ch == '\\' && i + 1 < data.size())
+                field += data.at(++i);
+            else if (ch == ',')
+                endField();
+            else if (ch == ';') {
+                endField();
+                cells += row;
+                row = defaults;
+                saved = 0;
+            }
+            else
+                field += ch;
+        }
+        model->setValues(cells);
+    }
+    r.readNext();
+}
+
+void RecordTableParam::trackEdits() {
+    if (!beginTracking()) return;
+    connect(model, &RecordTableModel::edited, this, &ParamBase::changed);
+}
+
+void RecordTableParam::moveCurrent(int delta) {
+    const QModelIndex current = view->currentIndex();
+    if (!current.isValid()) return;
+    const int row = current.row();
+    const int to = row + delta;
+    if (to < 0 || to >= model->rowCount()) return;
+    // moveRow() takes the row before which the moved row is inserted
+    if (model->moveRow(QModelIndex(), row, QModelIndex(), delta > 0 ? to + 1 : to))
+        view->setCurrentIndex(model->index(to, current.column()));
+}
+
+QString RecordTableParam::escaped(const QString& s) {
+    QString out;
+    out.reserve(s.size());
+    for (const QChar ch : s) {
+        if (ch == '\\' || ch == ',' || ch == ';') out += '\\';
+        out += ch;
+    }
+    return out;
+}
+
+/* -------------------------------------
+   Variant Tree Parameter
+   ------------------------------------- */
+
+VariantTreeModel::VariantTreeModel(QObject* parent)
+    : QAbstractItemModel(parent) {
+    top.fetched = true;
+}
+
+void VariantTreeModel::setRoot(const QVariant& v) {
+    if (!top.children.empty() && rootValue() == v) return;
+    beginResetModel();
+    top.children.clear();
+    std::unique_ptr<Node> root(new Node);
+    root->parent = &top;
+    root->value = v;
+    top.children.push_back(std::move(root));
+    endResetModel();
+    emit edited();
+}
+
+QVariant VariantTreeModel::rootValue() const {
+    return top.children.empty() ? QVariant() : rebuild(top.children.front().get());
+}
+
+bool VariantTreeModel::isContainer(const QVariant& v) {
+    const int t = v.userType();
+    return t == QMetaType::QVariantMap || t == QMetaType::QVariantHash || t == QMetaType::QVariantList;
+}
+
+QString VariantTreeModel::leafText(const QVariant& v) {
+    switch (v.userType()) {
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return QString::number(v.toDouble(), 'g', QLocale::FloatingPointShortest);
+    case QMetaType::UnknownType:
+        return QString();
+    default:
+        return v.canConvert<QString>() ? v.toString() : QString("<%1>").arg(v.typeName());
+    }
+}
+
+QModelIndex VariantTreeModel::index(int row, int column, const QModelIndex& parent) const {
+    const Node* p = nodeOf(parent);
+    if (row < 0 || row >= int(p->children.size()) || column < 0 || column >= 3) return QModelIndex();
+    return createIndex(row, column, p->children[size_t(row)].get());
+}
+
+QModelIndex VariantTreeModel::parent(const QModelIndex& index) const {
+    if (!index.isValid()) return QModelIndex();
+    const Node* p = nodeOf(index)->parent;
+    if (p == &top) return QModelIndex();
+    return createIndex(p->row, 0, const_cast<Node*>(p));
+}
+
+int VariantTreeModel::rowCount(const QModelIndex& parent) const {
+    if (parent.column() > 0) return 0;
+    return int(nodeOf(parent)->children.size());
+}
+
+int VariantTreeModel::columnCount(const QModelIndex& parent) const {
+    Q_UNUSED(parent);
+    return 3;
+}
+
+bool VariantTreeModel::hasChildren(const QModelIndex& parent) const {
+    if (parent.column() > 0) return false;
+    const Node* n = nodeOf(parent);
+    if (n->fetched) return !n->children.empty();
+    // Unfetched containers report children without creating them, so the view shows an expander
+    const QVariant& v = n->value;
+    switch (v.userType()) {
+    case QMetaType::QVariantMap: return !v.toMap().isEmpty();
+    case QMetaType::QVariantHash: return !v.toHash().isEmpty();
+    case QMetaType::QVariantList: return !v.toList().isEmpty();
+    default: return false;
+    }
+}
+
+bool VariantTreeModel::canFetchMore(const QModelIndex& parent) const {
+    if (parent.column() > 0) return false;
+    const Node* n = nodeOf(parent);
+    return !n->fetched && isContainer(n->value);
+}
+
+void VariantTreeModel::fetchMore(const QModelIndex& parent) {
+    if (!canFetchMore(parent)) return;
+    Node* n = nodeOf(parent);
+    n->fetched = true;
+
+    // toMap(), toHash() and toList() share the data of the variant: nothing is copied
+    std::vector<std::unique_ptr<Node>> children;
+    auto add = [&](const QString& key, const QVariant& value) {
+        std::unique_ptr<Node> child(new Node);
+        child->parent = n;
+        child->row = int(children.size());
+        child->key = key;
+        child->value = value;
+        children.push_back(std::move(child));
+    };
+    const QVariant& v = n->value;
+    if (v.userType() == QMetaType::QVariantMap) {
+        const QVariantMap map = v.toMap();
+        children.reserve(size_t(map.size()));
+        for (auto it = map.cbegin(); it != map.cend(); ++it) add(it.key(), it.value());
+    }
+    else if (v.userType() == QMetaType::QVariantHash) {
+        const QVariantHash hash = v.toHash();
+        children.reserve(size_t(hash.size()));
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) add(it.key(), it.value());
+    }
+    else {
+        const QVariantList list = v.toList();
+        children.reserve(size_t(list.size()));
+        for (const QVariant& item : list) add(QString(), item);
+    }
+    if (children.empty()) return;
+
+    beginInsertRows(parent, 0, int(children.size()) - 1);
+    n->children = std::move(children);
+    endInsertRows();
+}
+
+QVariant VariantTreeModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+    const Node* n = nodeOf(index);
+    const QVariant& v = n->value;
+    const bool container = isContainer(v);
+    if (index.column() == 0) {
+        if (role != Qt::DisplayRole) return QVariant();
+        if (n->parent == &top) return QString("(root)");
+        return n->parent->value.userType() == QMetaType::QVariantList ? QString("[%1]").arg(n->row) : n->key;
+    }
+    if (index.column() == 2)
+        return role == Qt::DisplayRole ? QString(v.typeName()) : QVariant();
+
+    if (container) {
+        if (role != Qt::DisplayRole) return QVariant();
+        if (v.userType() == QMetaType::QVariantList) return QString("[%1 items]").arg(v.toList().size());
+        const int count = v.userType() == QMetaType::QVariantMap ? v.toMap().size() : v.toHash().size();
+        return QString("{%1 keys}").arg(count);
+    }
+    switch (role) {
+    case Qt::DisplayRole:
+        // Long strings are cut for display only: the view elides them anyway
+        return v.userType() == QMetaType::Bool ? QVariant() : QVariant(leafText(v).left(256));
+    case Qt::EditRole:
+        return v;
+    case Qt::CheckStateRole:
+        if (v.userType() == QMetaType::Bool) return int(v.toBool() ? Qt::Checked : Qt::Unchecked);
+        return QVariant();
+    case Qt::ToolTipRole:
+        return v.userType() == QMetaType::QString ? QVariant(v.toString().left(1024)) : QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+bool VariantTreeModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || index.column() != 1 || !(flags(index) & (Qt::ItemIsEditable | Qt::ItemIsUserCheckable)))
+        return false;
+    Node* n = nodeOf(index);
+    QVariant v;
+    if (n->value.userType() == QMetaType::Bool) {
+        if (role != Qt::CheckStateRole) return false;
+        v = value.toInt() == Qt::Checked;
+    }
+    else {
+        if (role != Qt::EditRole) return false;
+        v = value;
+        if (v.userType() != n->value.userType() && !v.convert(n->value.userType())) return false;
+    }
+    if (v == n->value) return true;
+    n->value = v;
+    emit dataChanged(index, index);
+    emit edited();
+    return true;
+}
+
+QVariant VariantTreeModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+    case 0: return QString("Key");
+    case 1: return QString("Value");
+    default: return QString("Type");
+    }
+}
+
+Qt::ItemFlags VariantTreeModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    Qt::ItemFlags f = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    if (index.column() != 1) return f;
+    switch (nodeOf(index)->value.userType()) {
+    case QMetaType::Bool:
+        return f | Qt::ItemIsUserCheckable | Qt::ItemNeverHasChildren;
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::QString:
+    case QMetaType::QDate:
+    case QMetaType::QTime:
+    case QMetaType::QDateTime:
+        return f | Qt::ItemIsEditable | Qt::ItemNeverHasChildren;
+    default:
+        return f;
+    }
+}
+
+const VariantTreeModel::Node* VariantTreeModel::nodeOf(const QModelIndex& index) const {
+    return index.isValid() ? static_cast<const Node*>(index.internalPointer()) : &top;
+}
+
+VariantTreeModel::Node* VariantTreeModel::nodeOf(const QModelIndex& index) {
+    return index.isValid() ? static_cast<Node*>(index.internalPointer()) : &top;
+}
+
+QVariant VariantTreeModel::rebuild(const Node* node) {
+    if (!node->fetched || !isContainer(node->value)) return node->value;
+    switch (node->value.userType()) {
+    case QMetaType::QVariantMap: {
+        QVariantMap map;
+        for (const std::unique_ptr<Node>& child : node->children) map.insert(child->key, rebuild(child.get()));
+        return map;
+    }
+    case QMetaType::QVariantHash: {
+        QVariantHash hash;
+        hash.reserve(int(node->children.size()));
+        for (const std::unique_ptr<Node>& child : node->children) hash.insert(child->key, rebuild(child.get()));
+        return hash;
+    }
+    default: {
+        QVariantList list;
+        list.reserve(int(node->children.size()));
+        for (const std::unique_ptr<Node>& child : node->children) list.append(rebuild(child.get()));
+        return list;
+    }
+    }
+}
+
+QWidget* VariantTreeDelegate::createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const {
+    switch (index.data(Qt::EditRole).userType()) {
+    case QMetaType::Bool:
+        return nullptr;
+    case QMetaType::Int: {
+        CompactSpinBox* spin = new CompactSpinBox(parent);
+        spin->setFrame(false);
+        spin->setRange(INT_MIN, INT_MAX);
+        return spin;
+    }
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong: {
+        QLineEdit* edit = new QLineEdit(parent);
+        edit->setFrame(false);
+        edit->setValidator(new QRegularExpressionValidator(QRegularExpression("-?\\d+"), edit));
+        return edit;
+    }
+    case QMetaType::Double:
+    case QMetaType::Float: {
+        QLineEdit* edit = new QLineEdit(parent);
+        edit->setFrame(false);
+        QDoubleValidator* validator = new QDoubleValidator(edit);
+        validator->setLocale(QLocale::c());
+        validator->setNotation(QDoubleValidator::ScientificNotation);
+        edit->setValidator(validator);
+        return edit;
+    }
+    default:
+        return QStyledItemDelegate::createEditor(parent, option, index);
+    }
+}
+
+void VariantTreeDelegate::setEditorData(QWidget* editor, const QModelIndex& index) const {
+    const QVariant v = index.data(Qt::EditRole);
+    if (QSpinBox* spin = qobject_cast<QSpinBox*>(editor))
+        spin->setValue(v.toInt());
+    else if (QLineEdit* edit = qobject_cast<QLineEdit*>(editor))
+        edit->setText(VariantTreeModel::leafText(v));
+    else
+        QStyledItemDelegate::setEditorData(editor, index);
+}
+
+void VariantTreeDelegate::setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const {
+    if (QSpinBox* spin = qobject_cast<QSpinBox*>(editor)) {
+        spin->interpretText();
+        model->setData(index, spin->value());
+    }
+    else if (QLineEdit* edit = qobject_cast<QLineEdit*>(editor))
+        model->setData(index, edit->text()); // Converted back to the type of the leaf
+    else
+        QStyledItemDelegate::setModelData(editor, model, index);
+}
+
+VariantTreeParam::VariantTreeParam(QString name, QVariant* p, QVariant def, QString tip, QWidget* parent)
+    : ParamBase(parent) {
+    this->name = name;
+    ptr = p;
+    defVal = def;
+
+    model = new VariantTreeModel(this);
+    view = new QTreeView(this);
+    view->setModel(model);
+    view->setItemDelegate(new VariantTreeDelegate(view));
+    view->setUniformRowHeights(true); // Rows are never measured one by one
+    view->setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed | QAbstractItemView::AnyKeyPressed);
+    view->setToolTip(tip);
+    setTree(*p);
+
+    widget = view;
+}
+
+void VariantTreeParam::apply() { *ptr = model->rootValue(); }
+
+void VariantTreeParam::reset() { setTree(defVal); }
+
+QVariant VariantTreeParam::storedValue() const { return *ptr; }
+
+QVariant VariantTreeParam::value() const { return model->rootValue(); }
+
+void VariantTreeParam::setValue(const QVariant& v) { setTree(v); }
+
+void VariantTreeParam::save(QXmlStreamWriter& w) const {
+    const QString text = encode(model->rootValue());
+    w.writeStartElement(name);
+    // Split so that no attribute comes near LoadLimits::maxAttributeLength
+    w.writeAttribute("data", text.left(ChunkLength));
+    for (int at = ChunkLength, i = 1; at < text.size(); at += ChunkLength, ++i)
+        w.writeAttribute(QString("data%1").arg(i), text.mid(at, ChunkLength));
+    w.writeEndElement();
+}
+
+void VariantTreeParam::load(QXmlStreamReader& r) {
+    const QXmlStreamAttributes attributes = r.attributes();
+    if (attributes.hasAttribute("data")) {
+        QString text = attributes.value("data").toString();
+        for (int i = 1; attributes.hasAttribute(QString("data%1").arg(i)); ++i)
+            text += attributes.value(QString("data%1").arg(i));
+        bool ok = false;
+        const QVariant v = decode(QStringRef(&text), &ok);
+        if (ok) setTree(v);
+    }
+    r.readNext();
+}
+
+void VariantTreeParam::trackEdits() {
+    if (!beginTracking()) return;
+    connect(model, &VariantTreeModel::edited, this, &ParamBase::changed);
+}
+
+QString VariantTreeParam::encode(const QVariant& v) {
+    QByteArray raw;
+    QDataStream out(&raw, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_15);
+    write(out, v);
+    return QString::fromLatin1(qCompress(raw).toBase64());
+}
+
+QVariant VariantTreeParam::decode(const QStringRef& text, bool* ok) {
+    *ok = false;
+    const QByteArray packed = QByteArray::fromBase64(text.toLatin1());
+    if (packed.size() < 4 || qFromBigEndian<quint32>(packed.constData()) > quint32(MaxBytes)) return QVariant();
+    const QByteArray raw = qUncompress(packed);
+    QDataStream in(raw);
+    in.setVersion(QDataStream::Qt_5_15);
+    QVariant v;
+    *ok = read(in, v, 0) && in.atEnd();
+    return *ok ? v : QVariant();
+}
+
+void VariantTreeParam::setTree(const QVariant& v) {
+    model->setRoot(v);
+    view->expand(model->index(0, 0));
+}
+
+/**
+ * @brief Check if a value type may be read as a single QDataStream value.
+ *
+ * QDataStream reads lists, maps and nested variants recursively, and a type of
+ * the application is read by name, which may alias one of them.
+ * @param type Type id as written in the stream.
+ */
+static bool isFlatVariantType(quint32 type) {
+    return type != QMetaType::QVariantList && type != QMetaType::QVariantMap && type != QMetaType::QVariantHash
+        && type != QMetaType::QStringList && type != QMetaType::QVariant && type < QMetaType::User;
+}
+
+void VariantTreeParam::write(QDataStream& out, const QVariant& v) {
+    switch (v.userType()) {
+    case QMetaType::QVariantMap: {
+        const QVariantMap map = v.toMap();
+        out << quint8('m') << quint32(map.size());
+        for (auto it = map.cbegin(); it != map.cend(); ++it) {
+            out << it.key();
+            write(out, it.value());
+        }
+        break;
+    }
+    case QMetaType::QVariantHash: {
+        const QVariantHash hash = v.toHash();
+        out << quint8('h') << quint32(hash.size());
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            out << it.key();
+            write(out, it.value());
+        }
+        break;
+    }
+    case QMetaType::QVariantList: {
+        const QVariantList list = v.toList();
+        out << quint8('l') << quint32(list.size());
+        for (const QVariant& item : list) write(out, item);
+        break;
+    }
+    case QMetaType::QStringList: {
+        const QStringList list = v.toStringList();
+        out << quint8('s') << quint32(list.size());
+        for (const QString& item : list) out << item;
+        break;
+    }
+    default:
+        if (isFlatVariantType(quint32(v.userType())))
+            out << quint8('v') << v;
+        else // A type of the application: kept as its text, if any
+            out << quint8('v') << (v.canConvert<QString>() ? QVariant(v.toString()) : QVariant());
+    }
+}
+
+bool VariantTreeParam::read(QDataStream& in, QVariant& v, int depth) {
+    if (depth > MaxDepth) return false;
+    quint8 tag = 0;
+    in >> tag;
+    if (tag == 'v') {
+        // QDataStream recurses through containers before returning: reject them from the type id that leads the value
+        const QByteArray type = in.device()->peek(4);
+        if (type.size() < 4 || !isFlatVariantType(qFromBigEndian<quint32>(type.constData()))) return false;
+        in >> v;
+        return in.status() == QDataStream::Ok;
+    }
+    quint32 count = 0;
+    in >> count;
+    // Every entry takes at least one byte, so a count beyond the remaining data is malformed
+    if (in.status() != QDataStream::Ok || count > quint64(in.device()->bytesAvailable())) return false;
+    switch (tag) {
+    case 'm': {
+        QVariantMap map;
+        for (quint32 i = 0; i < count; ++i) {
+            QString key;
+            QVariant item;
+            in >> key;
+            if (in.status() != QDataStream::Ok || !read(in, item, depth + 1)) return false;
+            map.insert(key, item);
+        }
+        v = map;
+        return true;
+    }
+    case 'h': {
+        QVariantHash hash;
+        for (quint32 i = 0; i < count; ++i) {
+            QString key;
+            QVariant item;
+            in >> key;
+            if (in.status() != QDataStream::Ok || !read(in, item, depth + 1)) return false;
+            hash.insert(key, item);
+        }
+        v = hash;
+        return true;
+    }
+    case 'l': {
+        QVariantList list;
+        list.reserve(int(count));
+        for (quint32 i = 0; i < count; ++i) {
+            QVariant item;
+            if (!read(in, item, depth + 1)) return false;
+            list.append(item);
+        }
+        v = list;
+        return true;
+    }
+    case 's': {
+        QStringList list;
+        list.reserve(int(count));
+        for (quint32 i = 0; i < count; ++i) {
+            QString item;
+            in >> item;
+            if (in.status() != QDataStream::Ok) return false;
+            list.append(item);
+        }
+        v = list;
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/* -------------------------------------
+   Scrollable Tab Page
+   ------------------------------------- */
+
+ParamPage::ParamPage(QWidget* parent)
+    : QAbstractScrollArea(parent) {
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    viewport()->setBackgroundRole(QPalette::Window);
+    rowHeight = standardRowHeight();
+    rowTop.append(0);
+}
+
+int ParamPage::standardRowHeight() {
+    static int height = 0;
+    if (height == 0) {
+        QLineEdit edit;
+        QComboBox combo;
+        QPushButton button;
+        height = qMax(edit.sizeHint().height(), qMax(combo.sizeHint().height(), button.sizeHint().height())) + 6;
+    }
+    return height;
+}
+
+void ParamPage::addRow(ParamBase* param) {
+    param->setParent(viewport());
+    param->hide();
+    rows.append(param);
+    rowTop.append(rowTop.last() + (param->rowHeightHint() > 0 ? param->rowHeightHint() : rowHeight));
+    updateScrollRange();
+    scheduleRelayout();
+}
+
+void ParamPage::ensureVisible(ParamBase* param) {
+    int index = rows.indexOf(param);
+    if (index < 0) return;
+    QScrollBar* bar = verticalScrollBar();
+    if (rowTop[index] < bar->value())
+        bar->setValue(rowTop[index]);
+    else if (rowTop[index + 1] > bar->value() + viewport()->height())
+        bar->setValue(rowTop[index + 1] - viewport()->height());
+}
+
+QVector<ParamBase*> ParamPage::selectedParams() const {
+    QVector<ParamBase*> result;
+    if (selection.isEmpty()) return result;
+    result.reserve(selection.size());
+    for (ParamBase* param : rows)
+        if (selection.contains(param))
+            result.append(param);
+    return result;
+}
+
+void ParamPage::clearSelection() {
+    for (ParamBase* param : qAsConst(selection))
+        highlight(param, false);
+    selection.clear();
+    anchor = -1;
+    emit selectionChanged();
+}
+
+bool ParamPage::eventFilter(QObject* o, QEvent* e) {
+    if (e->type() == QEvent::MouseButtonPress) {
+        QMouseEvent* me = static_cast<QMouseEvent*>(e);
+        ParamBase* param = qobject_cast<ParamBase*>(o->parent());
+        if (me->button() == Qt::LeftButton && param && param->label == o) {
+            selectRow(rows.indexOf(param), me->modifiers());
+            return true;
+        }
+    }
+    return QAbstractScrollArea::eventFilter(o, e);
+}
+
+QSize ParamPage::sizeHint() const {
+    const int width = qMax(contentWidth, 480) + verticalScrollBar()->sizeHint().width();
+    const int height = qBound(rowHeight * 4, rowTop.last(), rowHeight * 20);
+    return QSize(width, height);
+}
+
+void ParamPage::scrollContentsBy(int, int) { relayout(); }
+
+void ParamPage::contextMenuEvent(QContextMenuEvent* e) {
+    emit contextMenuRequested(e->globalPos());
+}
+
+void ParamPage::resizeEvent(QResizeEvent* e) {
+    QAbstractScrollArea::resizeEvent(e);
+    updateScrollRange();
+    relayout();
+}
+
+void ParamPage::showEvent(QShowEvent* e) {
+    QAbstractScrollArea::showEvent(e);
+    relayout();
+}
+
+void ParamPage::updateScrollRange() {
+    QScrollBar* bar = verticalScrollBar();
+    bar->setRange(0, qMax(0, rowTop.last() - viewport()->height()));
+    bar->setPageStep(viewport()->height());
+    bar->setSingleStep(rowHeight);
+}
+
+void ParamPage::scheduleRelayout() {
+    if (relayoutPending || !isVisible()) return;
+    relayoutPending = true;
+    QMetaObject::invokeMethod(this, &ParamPage::relayout, Qt::QueuedConnection);
+}
+
+void ParamPage::relayout() {
+    relayoutPending = false;
+    const int top = verticalScrollBar()->value();
+    const int bottom = top + viewport()->height();
+    const int width = viewport()->width();
+
+    int first = int(std::upper_bound(rowTop.constBegin(), rowTop.constEnd(), top) - rowTop.constBegin()) - 1;
+    int last = int(std::lower_bound(rowTop.constBegin(), rowTop.constEnd(), bottom) - rowTop.constBegin());
+    first = qMax(0, first);
+    last = qMin(last, rows.size());
+
+    for (int i = firstVisible; i < lastVisible && i < rows.size(); ++i)
+        if (i < first || i >= last)
+            rows[i]->hide();
+
+    for (int i = first; i < last; ++i) {
+        ParamBase* param = rows[i];
+        if (!param->layout())
+            realizeRow(param);
+        param->setGeometry(0, rowTop[i] - top, width, rowTop[i + 1] - rowTop[i]);
+        if (param->isHidden())
+            param->show();
+    }
+    firstVisible = first;
+    lastVisible = last;
+}
+
+void ParamPage::selectRow(int index, Qt::KeyboardModifiers modifiers) {
+    if (index < 0) return;
+    if (modifiers & Qt::ShiftModifier && anchor >= 0) {
+        const int from = qMin(anchor, index);
+        const int to = qMax(anchor, index);
+        for (int i = from; i <= to; ++i) {
+            selection.insert(rows[i]);
+            highlight(rows[i], true);
+        }
+    }
+    else if (modifiers & Qt::ControlModifier) {
+        const bool on = !selection.contains(rows[index]);
+        if (on) selection.insert(rows[index]);
+        else selection.remove(rows[index]);
+        highlight(rows[index], on);
+        anchor = index;
+    }
+    else {
+        for (ParamBase* param : qAsConst(selection))
+            highlight(param, false);
+        selection.clear();
+        selection.insert(rows[index]);
+        highlight(rows[index], true);
+        anchor = index;
+    }
+    emit selectionChanged();
+}
+
+void ParamPage::highlight(ParamBase* param, bool on) {
+    if (!param->label) return;
+    param->label->setBackgroundRole(on ? QPalette::Highlight : QPalette::Window);
+    param->label->setForegroundRole(on ? QPalette::HighlightedText : QPalette::WindowText);
+}
+
+void ParamPage::realizeRow(ParamBase* param) {
+    QHBoxLayout* row = new QHBoxLayout(param);
+    row->setContentsMargins(6, 0, 6, 0);
+    row->addStretch(); // Spinge tutto verso destra
+
+    QLabel* label = new QLabel(param->name);
+    label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    label->setFixedWidth(120); // Larghezza fissa per allineare le etichette
+    label->setAutoFillBackground(true);
+    label->installEventFilter(this);
+    row->addWidget(label);
+    param->label = label;
+    highlight(param, selection.contains(param));
+
+    if (!param->widget) param->createWidget();
+
+    // Imposta una larghezza fissa per il widget del parametro per uniformità
+    if (param->widget) {
+        param->widget->setSizePolicy(QSizePolicy::Preferred,
+            param->rowHeightHint() > 0 ? QSizePolicy::Expanding : QSizePolicy::Fixed);
+        param->widget->setMinimumWidth(200); // Larghezza minima per i widget
+        row->addWidget(param->widget);
+    }
+
+    if (dynamic_cast<FilePathParam*>(param) || dynamic_cast<DirParam*>(param) || dynamic_cast<ImageParam*>(param)) {
+        QPushButton* browseBtn = new QPushButton("BROWSE");
+        browseBtn->setFixedWidth(60);
+        browseBtn->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+        row->addWidget(browseBtn);
+        param->browseButton = browseBtn;
+        if (FilePathParam* fileParam = dynamic_cast<FilePathParam*>(param)) {
+            QObject::connect(browseBtn, &QPushButton::clicked, fileParam, &FilePathParam::onBrowseClicked);
+        }
+        else if (DirParam* dirParam = dynamic_cast<DirParam*>(param)) {
+            QObject::connect(browseBtn, &QPushButton::clicked, dirParam, &DirParam::onBrowseClicked);
+        }
+        else if (ImageParam* imageParam = dynamic_cast<ImageParam*>(param)) {
+            QObject::connect(browseBtn, &QPushButton::clicked, imageParam, &ImageParam::onBrowseClicked);
+        }
+    }
+
+    QPushButton* defBtn = new QPushButton("DEF");
+    defBtn->setFixedWidth(40);
+    defBtn->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+    defBtn->setToolTip("Set default value");
+    row->addWidget(defBtn);
+    param->defButton = defBtn;
+    QObject::connect(defBtn, &QPushButton::clicked, param, [param]() { param->reset(); });
+
+    const int width = row->sizeHint().width();
+    if (width > contentWidth) {
+        contentWidth = width;
+        updateGeometry();
+    }
+    emit rowRealized(param);
+}
+
+ParamValuesCommand::ParamValuesCommand(const QString& text, QWidget* view, const QVector<ParamBase*>& params,
+    const QVariantList& oldValues, const QVariantList& newValues, bool applied)
+    : view(view), params(params), oldValues(oldValues), newValues(newValues), skipRedo(applied) {
+    setText(text);
+}
+
+void ParamValuesCommand::undo() { assign(oldValues); }
+
+void ParamValuesCommand::redo() {
+    if (skipRedo) {
+        skipRedo = false;
+        return;
+    }
+    assign(newValues);
+}
+
+void ParamValuesCommand::assign(const QVariantList& values) {
+    const bool suspend = view && view->updatesEnabled();
+    if (suspend) view->setUpdatesEnabled(false);
+    for (int i = 0; i < params.size(); ++i)
+        params[i]->setValue(values.at(i));
+    if (suspend) view->setUpdatesEnabled(true);
+}
+
+/* -------------------------------------
+   Lock-free Queue and Audit Log
+   ------------------------------------- */
+
+ParamAuditLog::ParamAuditLog(const QString& path, qint64 maxBytes, int maxFiles,
+    size_t capacity, QObject* parent)
+    : QObject(parent), writer(new ParamAuditWriter(path, maxBytes, maxFiles, capacity)) {
+    user = qEnvironmentVariable("USER", qEnvironmentVariable("USERNAME"));
+    connect(writer.get(), &ParamAuditWriter::writeFailed, this, &ParamAuditLog::writeFailed);
+}
+
+ParamAuditLog::~ParamAuditLog() {
+    stop();
+}
+
+void ParamAuditLog::start() {
+    writer->start();
+}
+
+bool ParamAuditLog::record(const QString& name, const QVariant& oldValue, const QVariant& newValue) {
+    ParamAuditWriter::Record r;
+    r.timestamp = QDateTime::currentMSecsSinceEpoch();
+    r.user = user;
+    r.name = name;
+    r.oldValue = oldValue;
+    r.newValue = newValue;
+    return writer->push(std::move(r));
+}
+
+void ParamAuditLog::stop() {
+    writer->stop();
+}
+
+quint64 ParamAuditLog::droppedCount() const { return writer->droppedCount(); }
+
+quint64 ParamAuditLog::lostCount() const { return writer->lostCount(); }
+
+QString ParamAuditLog::valueText(const QVariant& v) {
+    switch (v.userType()) {
+    case QMetaType::QVariantList: {
+        QStringList items;
+        for (const QVariant& item : v.toList())
+            items << valueText(item);
+        return items.join(',');
+    }
+    case QMetaType::QStringList: return v.toStringList().join(',');
+    case QMetaType::QColor: return v.value<QColor>().name(QColor::HexArgb);
+    case QMetaType::QFont: return v.value<QFont>().toString();
+    case QMetaType::QPoint: return QString("%1,%2").arg(v.toPoint().x()).arg(v.toPoint().y());
+    case QMetaType::QSize: return QString("%1x%2").arg(v.toSize().width()).arg(v.toSize().height());
+    case QMetaType::QRect: {
+        const QRect rc = v.toRect();
+        return QString("%1,%2 %3x%4").arg(rc.x()).arg(rc.y()).arg(rc.width()).arg(rc.height());
+    }
+    case QMetaType::QDateTime: return v.toDateTime().toString(Qt::ISODateWithMs);
+    default:
+        break;
+    }
+    if (v.userType() == qMetaTypeId<QVector<float>>()) {
+        // A lookup table: its size and a digest, not a million numbers
+        const QVector<float> values = v.value<QVector<float>>();
+        return QString("float[%1]#%2").arg(values.size())
+            .arg(qHashBits(values.constData(), size_t(values.size()) * sizeof(float)), 8, 16, QLatin1Char('0'));
+    }
+    if (v.canConvert<QString>())
+        return v.toString();
+    QString text;
+    QDebug(&text).noquote() << v;
+    return text;
+}
+
+ParamAuditWriter::ParamAuditWriter(const QString& path, qint64 maxBytes, int maxFiles, size_t capacity)
+    : queue(capacity), path(path), maxBytes(maxBytes), maxFiles(maxFiles) {}
+
+bool ParamAuditWriter::push(Record r) {
+    const bool queued = queue.tryPush(std::move(r));
+    if (!queued) dropped.fetch_add(1, std::memory_order_relaxed);
+    wake.release();
+    return queued;
+}
+
+void ParamAuditWriter::stop() {
+    stopping.store(true);
+    wake.release();
+    wait();
+}
+
+void ParamAuditWriter::run() {
+    QFile file(path);
+    QByteArray batch;
+    int batchRecords = 0;
+    quint64 reportedDrops = 0;
+    quint64 reportedLost = 0;
+    QString reportedError;
+    bool writable = true;
+    for (;;) {
+        const bool last = stopping.load();
+        wake.tryAcquire(wake.available());
+        Record r;
+        while (queue.tryPop(r)) {
+            batch += formatLine(r);
+            ++batchRecords;
+        }
+        const QByteArray now = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs).toUtf8();
+        const quint64 drops = dropped.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            batch += now + "\t-\t-\tQUEUE OVERFLOW\t" + QByteArray::number(drops - reportedDrops) + " records dropped\n";
+            reportedDrops = drops;
+        }
+        // Noted once the file can be written again, so the note is not lost itself
+        const quint64 lostNow = lost.load(std::memory_order_relaxed);
+        if (lostNow != reportedLost && writable) {
+            batch += now + "\t-\t-\tWRITE FAILURE\t" + QByteArray::number(lostNow - reportedLost) + " records lost\n";
+            reportedLost = lostNow;
+        }
+        if (!batch.isEmpty()) {
+            QString error;
+            writable = writeBatch(file, batch, &error);
+            if (writable) batchRecords = 0;
+            else if (batch.size() > maxBytes || last) {
+                lost.fetch_add(quint64(batchRecords), std::memory_order_relaxed);
+                batch.clear();
+                batchRecords = 0;
+            }
+            if (error != reportedError && !error.isEmpty()) emit writeFailed(error);
+            reportedError = error;
+        }
+        if (last) break;
+        // Sleep until record() or stop(); a failed batch is retried after a second
+        if (!batch.isEmpty()) wake.tryAcquire(1, 1000);
+        else if (!writable || lost.load(std::memory_order_relaxed) == reportedLost) wake.acquire();
+    }
+}
+
+QByteArray ParamAuditWriter::formatLine(const Record& r) {
+    QStringList fields;
+    fields << QDateTime::fromMSecsSinceEpoch(r.timestamp, Qt::UTC).toString(Qt::ISODateWithMs)
+        << r.user << r.name << ParamAuditLog::valueText(r.oldValue) << ParamAuditLog::valueText(r.newValue);
+    for (QString& field : fields) {
+        field.replace(QLatin1Char('\\'), QLatin1String("\\\\"));
+        field.replace(QLatin1Char('\t'), QLatin1String("\\t"));
+        field.replace(QLatin1Char('\n'), QLatin1String("\\n"));
+    }
+    return fields.join(QLatin1Char('\t')).toUtf8() + '\n';
+}
+
+bool ParamAuditWriter::writeBatch(QFile& file, QByteArray& batch, QString* error) {
+    if (file.isOpen() && file.size() > 0 && file.size() + batch.size() > maxBytes && !rotate(file))
+        *error = QString("%1: cannot rename to %1.1, writing on").arg(path);
+    // Unbuffered: write() reports what actually reached the file
+    if (!file.isOpen() && !file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text | QIODevice::Unbuffered)) {
+        *error = QString("%1: %2").arg(path, file.errorString());
+        return false;
+    }
+    const qint64 written = file.write(batch);
+    if (written > 0) batch.remove(0, int(written));
+    if (batch.isEmpty()) return true;
+    *error = QString("%1: %2").arg(path, file.errorString());
+    file.close(); // Reopened on the next attempt
+    return false;
+}
+
+bool ParamAuditWriter::rotate(QFile& file) {
+    file.close();
+    QFile::remove(QString("%1.%2").arg(path).arg(maxFiles));
+    for (int i = maxFiles - 1; i >= 1; --i)
+        QFile::rename(QString("%1.%2").arg(path).arg(i), QString("%1.%2").arg(path).arg(i + 1));
+    return maxFiles > 0 ? QFile::rename(path, path + ".1") : QFile::remove(path);
+}
+
+/* -------------------------------------
+   Monitor Parameter
+   ------------------------------------- */
+
+Sparkline::Sparkline(int length, QWidget* parent)
+    : QWidget(parent), lows(qMax(2, length)), highs(qMax(2, length)), outline(2 * qMax(2, length)) {
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+void Sparkline::append(float low, float high) {
+    lows[next] = low;
+    highs[next] = high;
+    next = (next + 1) % lows.size();
+    count = qMin(count + 1, lows.size());
+    update();
+}
+
+void Sparkline::clear() {
+    next = 0;
+    count = 0;
+    update();
+}
+
+QSize Sparkline::sizeHint() const { return QSize(lows.size(), fontMetrics().height()); }
+
+void Sparkline::paintEvent(QPaintEvent* e) {
+    QPainter painter(this);
+    painter.fillRect(e->rect(), palette().base());
+    if (count == 0) return;
+
+    const int first = (next - count + lows.size()) % lows.size();
+    float lo = lows[first];
+    float hi = highs[first];
+    for (int i = 1; i < count; ++i) {
+        const int k = (first + i) % lows.size();
+        lo = qMin(lo, lows[k]);
+        hi = qMax(hi, highs[k]);
+    }
+    const QRectF area = QRectF(rect()).adjusted(1, 2, -1, -2);
+    const double sy = hi > lo ? area.height() / (hi - lo) : 0.0;
+    const double midY = area.center().y();
+    const double sx = area.width() / (lows.size() - 1);
+    // Newest frame at the right edge: maxima left to right, then minima back
+    const double x0 = area.right() - (count - 1) * sx;
+    for (int i = 0; i < count; ++i) {
+        const int k = (first + i) % lows.size();
+        const double x = x0 + i * sx;
+        outline[i] = QPointF(x, sy > 0 ? area.bottom() - (highs[k] - lo) * sy : midY);
+        outline[2 * count - 1 - i] = QPointF(x, sy > 0 ? area.bottom() - (lows[k] - lo) * sy : midY);
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(palette().text().color(), 1));
+    painter.setBrush(palette().text());
+    painter.drawPolygon(outline.constData(), 2 * count);
+}
+
+MonitorParam::MonitorParam(QString name, QString suffix, int decimals, QString tip, int history, QWidget* parent)
+    : ParamBase(parent), samples(new LockFreeQueue<double>(QueueCapacity)), suffix(suffix), decimals(decimals), last(qQNaN()) {
+    this->name = name;
+    QWidget* box = new QWidget(this);
+    QHBoxLayout* layout = new QHBoxLayout(box);
+    layout->setContentsMargins(0, 0, 0, 0);
+    valueLabel = new QLabel("-", box);
+    valueLabel->setMinimumWidth(valueLabel->fontMetrics().horizontalAdvance(QString(8, '0') + suffix));
+    valueLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    sparkline = new Sparkline(history, box);
+    layout->addWidget(valueLabel);
+    layout->addWidget(sparkline, 1);
+    box->setToolTip(tip);
+    widget = box;
+
+    refresh = new QTimer(this);
+    refresh->setInterval(RefreshInterval);
+    connect(refresh, &QTimer::timeout, this, &MonitorParam::refreshDisplay);
+}
+
+// Out of line: LockFreeQueue is only complete here
+MonitorParam::~MonitorParam() {}
+
+bool MonitorParam::post(double v) {
+    if (!showing.load(std::memory_order_relaxed)) return true;
+    if (samples->tryPush(v)) return true;
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void MonitorParam::apply() {}
+
+void MonitorParam::reset() { sparkline->clear(); }
+
+void MonitorParam::save(QXmlStreamWriter& w) const { Q_UNUSED(w); }
+
+void MonitorParam::load(QXmlStreamReader& r) { r.readNext(); }
+
+void MonitorParam::showEvent(QShowEvent* e) {
+    ParamBase::showEvent(e);
+    // Samples left from before the row was hidden would show up late
+    double v;
+    while (samples->tryPop(v)) {}
+    showing.store(true, std::memory_order_relaxed);
+    refresh->start();
+}
+
+void MonitorParam::hideEvent(QHideEvent* e) {
+    ParamBase::hideEvent(e);
+    refresh->stop();
+    showing.store(false, std::memory_order_relaxed);
+}
+
+void MonitorParam::refreshDisplay() {
+    double v;
+    if (!samples->tryPop(v)) return;
+    double lo = v;
+    double hi = v;
+    // Bounded, so that a producer faster than the GUI cannot stretch a frame
+    for (size_t n = samples->capacity(); n > 0 && samples->tryPop(v); --n) {
+        lo = qMin(lo, v);
+        hi = qMax(hi, v);
+    }
+    if (v != last) {
+        last = v;
+        valueLabel->setText(QString::number(v, 'f', decimals) + suffix);
+    }
+    sparkline->append(float(lo), float(hi));
+}
+
+/* -------------------------------------
+   Shared Value Store
+   ------------------------------------- */
+
+/// Child of a store view holding a share of its value, released after the view.
+class StoreValueOwner : public QObject {
+    std::shared_ptr<void> value; ///< Value referenced by the view.
+public:
+    StoreValueOwner(const std::shared_ptr<void>& value, QObject* parent) : QObject(parent), value(value) {}
+};
+
+QVariant ParamStore::value(int handle) const { return entries.at(handle).read(); }
+
+ParamBase* ParamStore::createView(int handle) {
+    if (handle < 0 || handle >= entries.size()) return nullptr;
+    Entry& e = entries[handle];
+    e.views.removeAll(QPointer<ParamBase>());
+    ParamBase* view = e.create();
+    new StoreValueOwner(e.slot, view);
+    e.views.append(view);
+    connect(view, &ParamBase::changed, this, [this, handle, view]() { mirror(handle, view); });
+    // The view's apply() has written the shared value
+    connect(view, &ParamBase::applied, this, [this, handle, view]() { refresh(handle, view); });
+    return view;
+}
+
+void ParamStore::mirror(int handle, ParamBase* source) {
+    if (!source->isValid()) return;
+    const QVariant v = source->value();
+    for (const QPointer<ParamBase>& view : entries.at(handle).views) {
+        if (!view || view == source) continue;
+        // Blocked: the mirrored view must not commit back or mark itself edited
+        const QSignalBlocker blocker(view.data());
+        view->setValue(v);
+    }
+}
+
+void ParamStore::refresh(int handle, ParamBase* source) {
+    for (const QPointer<ParamBase>& view : entries.at(handle).views) {
+        if (!view || view == source) continue;
+        // Blocked: the refreshed view must not commit back or mark itself edited
+        const QSignalBlocker blocker(view.data());
+        view->setValue(view->storedValue());
+    }
+    emit valueChanged(handle);
+}
+
+/* -------------------------------------
+   Latency Instrumentation
+   ------------------------------------- */
+
+int LatencyHistogram::bucketOf(quint64 v) {
+    const quint64 limit = (quint64(1) << (MaxShift + 6)) - 1;
+    if (v > limit) v = limit;
+    if (v < quint64(2 * SubBuckets)) return int(v);
+    // v has msb bits: the top 6 of them pick the sub-bucket of its power of two
+    const int shift = 63 - int(qCountLeadingZeroBits(v)) - 5;
+    return (shift + 1) * SubBuckets + int(v >> shift) - SubBuckets;
+}
+
+qint64 LatencyHistogram::bucketHigh(int index) {
+    if (index < 2 * SubBuckets) return index;
+    const int shift = index / SubBuckets - 1;
+    const qint64 low = qint64(index % SubBuckets + SubBuckets) << shift;
+    return low + (qint64(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 ns) {
+    if (ns < 0) ns = 0;
+    ++buckets[bucketOf(quint64(ns))];
+    lowest = total ? qMin(lowest, ns) : ns;
+    highest = qMax(highest, ns);
+    sum += double(ns);
+    ++total;
+}
+
+void LatencyHistogram::clear() {
+    std::fill(std::begin(buckets), std::end(buckets), quint64(0));
+    total = 0;
+    lowest = highest = 0;
+    sum = 0.0;
+}
+
+qint64 LatencyHistogram::valueAt(double percentile) const {
+    if (!total) return 0;
+    const double p = qBound(0.0, percentile, 100.0);
+    const quint64 wanted = qMax<quint64>(1, quint64(std::ceil(p / 100.0 * double(total))));
+    quint64 seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= wanted) return qMin(bucketHigh(i), highest);
+    }
+    return highest;
+}
+
+/**
+ * @struct LatencyState
+ * @brief Clock and histograms of ParamLatency.
+ */
+struct LatencyState {
+    /**
+     * @struct TypeHistograms
+     * @brief Histograms of one parameter type, one per stage.
+     */
+    struct TypeHistograms {
+        LatencyHistogram stages[ParamLatency::StageCount];
+    };
+
+    QElapsedTimer                                   clock;
+    qint64                                          enabledAt = 0; ///< Clock time of the last enabling; older stamps are stale.
+    bool                                            enabled = false;
+    QHash<const QMetaObject*, TypeHistograms*>      types; ///< Owned; kept until the process ends.
+};
+
+static LatencyState& latencyState() {
+    static LatencyState state;
+    return state;
+}
+
+static qint64 latencyNow() {
+    LatencyState& state = latencyState();
+    if (!state.clock.isValid()) state.clock.start();
+    // Never 0: a zero stamp means "no edit pending"
+    return state.clock.nsecsElapsed() + 1;
+}
+
+void ParamLatency::setEnabled(bool on) {
+    LatencyState& state = latencyState();
+    if (on && !state.enabled) state.enabledAt = latencyNow();
+    state.enabled = on;
+}
+
+bool ParamLatency::isEnabled() { return latencyState().enabled; }
+
+void ParamLatency::input(ParamBase* param) {
+    if (latencyState().enabled) param->latencyStamp = latencyNow();
+}
+
+void ParamLatency::committed(ParamBase* param, bool flushed) {
+    const LatencyState& state = latencyState();
+    if (!state.enabled) return;
+    if (param->latencyStamp < state.enabledAt) param->latencyStamp = 0;
+    if (!param->latencyStamp && param->isAncestorOf(QApplication::focusWidget())) input(param);
+    record(param, Commit);
+    // Without live apply the value waits for an Apply click, which stamps anew
+    if (!flushed) param->latencyStamp = 0;
+}
+
+void ParamLatency::record(ParamBase* param, Stage stage) {
+    LatencyState& state = latencyState();
+    if (!state.enabled || !param->latencyStamp) return;
+    if (param->latencyStamp < state.enabledAt) {
+        param->latencyStamp = 0;
+        return;
+    }
+    const qint64 elapsed = latencyNow() - param->latencyStamp;
+    LatencyState::TypeHistograms*& h = state.types[param->metaObject()];
+    if (!h) h = new LatencyState::TypeHistograms;
+    h->stages[stage].record(elapsed);
+    if (stage == Publish) param->latencyStamp = 0;
+}
+
+QStringList ParamLatency::types() {
+    QStringList names;
+    const auto& all = latencyState().types;
+    for (auto it = all.cbegin(); it != all.cend(); ++it)
+        names.append(QString::fromLatin1(it.key()->className()));
+    names.sort();
+    return names;
+}
+
+const LatencyHistogram* ParamLatency::histogram(const QString& type, Stage stage) {
+    if (stage < 0 || stage >= StageCount) return nullptr;
+    const auto& all = latencyState().types;
+    for (auto it = all.cbegin(); it != all.cend(); ++it)
+        if (type == QLatin1String(it.key()->className())) return &it.value()->stages[stage];
+    return nullptr;
+}
+
+QString ParamLatency::stageName(Stage stage) {
+    switch (stage) {
+    case Commit: return QStringLiteral("commit");
+    case Apply: return QStringLiteral("apply");
+    case Publish: return QStringLiteral("publish");
+    default: return QString();
+    }
+}
+
+QString ParamLatency::toCsv() {
+    const auto us = [](double ns) { return QString::number(ns / 1000.0, 'f', 1); };
+    QString csv = QStringLiteral("type,stage,count,min_us,mean_us,p50_us,p90_us,p99_us,p999_us,max_us\n");
+    for (const QString& type : types()) {
+        for (int s = 0; s < StageCount; ++s) {
+            const LatencyHistogram* h = histogram(type, Stage(s));
+            if (!h->count()) continue;
+            csv += type + QLatin1Char(',') + stageName(Stage(s)) + QLatin1Char(',') + QString::number(h->count())
+                + QLatin1Char(',') + us(h->min()) + QLatin1Char(',') + us(h->mean())
+                + QLatin1Char(',') + us(h->valueAt(50)) + QLatin1Char(',') + us(h->valueAt(90))
+                + QLatin1Char(',') + us(h->valueAt(99)) + QLatin1Char(',') + us(h->valueAt(99.9))
+                + QLatin1Char(',') + us(h->max()) + QLatin1Char('\n');
+        }
+    }
+    return csv;
+}
+
+bool ParamLatency::exportCsv(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) return false;
+    return file.write(toCsv().toUtf8()) >= 0;
+}
+
+void ParamLatency::clear() {
+    for (LatencyState::TypeHistograms* h : latencyState().types)
+        for (LatencyHistogram& stage : h->stages) stage.clear();
+}
+
+/* -------------------------------------
+   Main Editor Dialog Class
+   ------------------------------------- */
+
+ParamsEditor::ParamsEditor(QWidget* parent)
+    : QDialog(parent) {
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    tabs = new QTabWidget(this);
+    mainLayout->addWidget(tabs);
+
+    QHBoxLayout* btnLayout = new QHBoxLayout;
+    applyBtn = new QPushButton("APPLY", this);
+    cancelBtn = new QPushButton("CANCEL", this);
+    btnLayout->addStretch();
+    btnLayout->addWidget(applyBtn);
+    btnLayout->addWidget(cancelBtn);
+    mainLayout->addLayout(btnLayout);
+
+    connect(applyBtn, &QPushButton::clicked, this, &ParamsEditor::onApplyClicked);
+    connect(cancelBtn, &QPushButton::clicked, this, &ParamsEditor::onCancelClicked);
+
+    undo = new QUndoStack(this);
+    QAction* undoAction = undo->createUndoAction(this);
+    undoAction->setShortcut(QKeySequence::Undo);
+    addAction(undoAction);
+    QAction* redoAction = undo->createRedoAction(this);
+    redoAction->setShortcut(QKeySequence::Redo);
+    addAction(redoAction);
+    QAction* copyAction = new QAction("Copy", this);
+    copyAction->setShortcut(QKeySequence::Copy);
+    connect(copyAction, &QAction::triggered, this, &ParamsEditor::copySelection);
+    addAction(copyAction);
+    QAction* pasteAction = new QAction("Paste", this);
+    pasteAction->setShortcut(QKeySequence::Paste);
+    connect(pasteAction, &QAction::triggered, this, [this]() { paste(); });
+    addAction(pasteAction);
+}
+
+ParamsEditor::~ParamsEditor() {
+    delete tabs;
+}
+
+int ParamsEditor::addTab(const QString& title, const QIcon& icon) {
+    ParamPage* page = new ParamPage;
+    int index = tabs->count();
+    tabs->addTab(page, icon, title);
+    pages.append(page);
+    connect(page, &ParamPage::contextMenuRequested, this, [this, index](const QPoint& pos) {
+        showContextMenu(index, pos);
+        });
+    connect(page, &ParamPage::rowRealized, this, &ParamsEditor::paramRealized);
+    allParams.append(QVector<ParamBase*>()); // Initialize parameter vector for this tab
+    return index;
+}
+
+void ParamsEditor::addParam(int tabIndex, ParamBase* param) {
+    if (tabIndex < 0 || tabIndex >= allParams.size()) return;
+    pages[tabIndex]->addRow(param);
+    allParams[tabIndex].append(param);
+    paramIndex.insert(param->name, param);
+    postTargets.append(param);
+    param->setInheritedCommitPolicy(commitPolicy, commitDebounce);
+    if (displayUnits.contains(param->unitDimension()))
+        param->setDisplayUnit(displayUnits.value(param->unitDimension()));
+    param->trackEdits();
+    connect(param, &ParamBase::changed, this, [this, tabIndex, param]() {
+        editedParams.insert(param);
+        ParamLatency::committed(param, liveApply && param->isValid());
+        if (liveApply && param->isValid())
+            applyParam(tabIndex, param);
+        });
+    connect(param, &ParamBase::validityChanged, this, [this, param](bool valid) { setParamValid(param, valid); });
+    connect(param, &QObject::destroyed, this, [this, param]() {
+        editedParams.remove(param);
+        setParamValid(param, true);
+        });
+    if (!param->isValid())
+        setParamValid(param, false);
+    emit paramAdded(tabIndex, param);
+}
+
+ParamBase* ParamsEditor::addStoreParam(int tabIndex, ParamStore* store, const QString& key) {
+    if (tabIndex < 0 || tabIndex >= allParams.size() || !store) return nullptr;
+    ParamBase* param = store->createView(store->handle(key));
+    if (param) addParam(tabIndex, param);
+    return param;
+}
+
+void ParamsEditor::setCommitPolicy(ParamBase::CommitPolicy policy, int debounceMs) {
+    commitPolicy = policy == ParamBase::InheritCommit ? ParamBase::CommitPerKeystroke : policy;
+    commitDebounce = debounceMs;
+    for (const QVector<ParamBase*>& tab : allParams)
+        for (ParamBase* param : tab)
+            param->setInheritedCommitPolicy(commitPolicy, commitDebounce);
+}
+
+bool ParamsEditor::applyAll() {
+    for (const QVector<ParamBase*>& tab : allParams)
+        for (ParamBase* param : tab) {
+            // A measured edit still pending is committed by this click
+            if (param->latencyStamp) ParamLatency::input(param);
+            param->commitEdit();
+        }
+    if (!invalidParams.isEmpty()) return false;
+    emit applying();
+    for (int tab = 0; tab < allParams.size(); ++tab)
+        for (auto* param : allParams[tab])
+            applyParam(tab, param);
+    editedParams.clear();
+    emit applied();
+    return true;
+}
+
+int ParamsEditor::paramHandle(const ParamBase* param) {
+    const int handle = postTargets.indexOf(const_cast<ParamBase*>(param));
+    if (handle < 0) return -1;
+    if (!postQueue) {
+        postQueue.reset(new LockFreeQueue<PostedValue>(PostQueueCapacity));
+        postTimer = new QTimer(this);
+        postTimer->setInterval(PostInterval);
+        connect(postTimer, &QTimer::timeout, this, &ParamsEditor::drainPostedValues);
+        if (isVisible()) postTimer->start();
+    }
+    return handle;
+}
+
+void ParamsEditor::showEvent(QShowEvent* e) {
+    QDialog::showEvent(e);
+    if (!postTimer) return;
+    drainPostedValues();
+    postTimer->start();
+}
+
+void ParamsEditor::hideEvent(QHideEvent* e) {
+    QDialog::hideEvent(e);
+    if (postTimer) postTimer->stop();
+}
+
+bool ParamsEditor::postValue(int handle, const QVariant& value) {
+    // postQueue is set before any producer has a handle, and never reset
+    if (handle < 0 || !postQueue) return false;
+    PostedValue posted;
+    posted.handle = handle;
+    posted.value = value;
+    if (postQueue->tryPush(std::move(posted))) return true;
+    droppedPosts.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ParamsEditor::drainPostedValues() {
+    // Bounded, so that producers faster than the GUI cannot stretch a frame
+    PostedValue posted;
+    for (size_t n = postQueue->capacity(); n > 0 && postQueue->tryPop(posted); --n) {
+        if (posted.handle >= postTargets.size() || !posted.value.isValid()) continue;
+        if (pendingPosts.size() < postTargets.size())
+            pendingPosts.resize(postTargets.size());
+        if (!pendingPosts[posted.handle].isValid())
+            pendingHandles.append(posted.handle);
+        pendingPosts[posted.handle] = std::move(posted.value);
+    }
+    if (pendingHandles.isEmpty()) return;
+    tabs->setUpdatesEnabled(false);
+    for (int handle : pendingHandles) {
+        if (ParamBase* param = postTargets[handle])
+            param->setValue(pendingPosts[handle]);
+        pendingPosts[handle] = QVariant();
+    }
+    pendingHandles.clear();
+    tabs->setUpdatesEnabled(true);
+}
+
+void ParamsEditor::setDisplayUnit(const QString& dimension, const QString& unit) {
+    if (dimension.isEmpty()) return;
+    const UnitConversion conversion = ParamUnits::instance().conversion(dimension, unit);
+    displayUnits.insert(dimension, conversion);
+    setUpdatesEnabled(false);
+    for (const QVector<ParamBase*>& tab : allParams)
+        for (ParamBase* param : tab)
+            if (param->unitDimension() == dimension)
+                param->setDisplayUnit(conversion);
+    setUpdatesEnabled(true);
+}
+
+QString ParamsEditor::displayUnit(const QString& dimension) const { return displayUnits.value(dimension).unit; }
+
+bool ParamsEditor::isRealized(const ParamBase* param) { return param->layout() != nullptr; }
+
+int ParamsEditor::tabCount() const { return allParams.size(); }
+
+QString ParamsEditor::tabTitle(int tabIndex) const { return tabs->tabText(tabIndex); }
+
+QVector<ParamBase*> ParamsEditor::params(int tabIndex) const { return allParams.value(tabIndex); }
+
+ParamBase* ParamsEditor::findParam(const QString& name) const { return paramIndex.value(name, nullptr); }
+
+QString ParamsEditor::mimeType() { return QStringLiteral("application/x-paramseditor-params"); }
+
+QMimeData* ParamsEditor::createMimeData(const QVector<ParamBase*>& params) const {
+    QVector<ParamBase*> encoded;
+    QVariantList values;
+    encoded.reserve(params.size());
+    values.reserve(params.size());
+    for (ParamBase* param : params) {
+        // Secrets never reach the system clipboard, in either format
+        if (qobject_cast<PasswordParam*>(param)) continue;
+        QVariant v = param->value();
+        if (!v.isValid()) continue;
+        encoded.append(param);
+        values.append(v);
+    }
+
+    QByteArray raw;
+    QDataStream out(&raw, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << ClipboardMagic << ClipboardVersion << quint32(encoded.size());
+    for (int i = 0; i < encoded.size(); ++i)
+        out << encoded[i]->name << values.at(i);
+
+    QString text;
+    QXmlStreamWriter writer(&text);
+    writer.setAutoFormatting(true);
+    writer.writeStartElement("Params");
+    for (const ParamBase* param : encoded)
+        param->save(writer);
+    writer.writeEndElement();
+
+    QMimeData* mime = new QMimeData;
+    mime->setData(mimeType(), qCompress(raw));
+    mime->setText(text);
+    return mime;
+}
+
+/**
+ * @brief Walk the elements of a parameter file, rejecting it as soon as a limit is exceeded.
+ *
+ * visit() is called on each start element and returns true if it read past it
+ * (ParamBase::load() reads one token); that token is then examined here instead
+ * of being skipped, so the element count and depth stay exact. A violation is
+ * raised as an error of the reader, which ends the walk.
+ * @return False if the XML is malformed or exceeds the limits.
+ */
+/**
+ * @brief Check that the reader still stands on the start element found at an offset.
+ *
+ * A self-closing element yields its EndElement at the same offset, so the
+ * offset alone does not show that a load() has read past it.
+ */
+static bool atStartElement(const QXmlStreamReader& r, qint64 at) {
+    return r.tokenType() == QXmlStreamReader::StartElement && r.characterOffset() == at;
+}
+
+template<typename Visit>
+static bool readParamElements(QXmlStreamReader& reader, const LoadLimits& limits, Visit visit) {
+    int elements = 0;
+    int depth = 0;
+    reader.readNext();
+    while (!reader.atEnd()) {
+        if (reader.isStartElement()) {
+            if (limits.maxElements > 0 && ++elements > limits.maxElements) {
+                reader.raiseError(QString("more than %1 elements").arg(limits.maxElements));
+                break;
+            }
+            if (limits.maxDepth > 0 && ++depth > limits.maxDepth) {
+                reader.raiseError(QString("elements nested deeper than %1 levels").arg(limits.maxDepth));
+                break;
+            }
+            if (limits.maxAttributeLength > 0) {
+                for (const QXmlStreamAttribute& a : reader.attributes()) {
+                    if (a.value().size() > limits.maxAttributeLength) {
+                        reader.raiseError(QString("attribute \"%1\" of <%2> longer than %3 characters")
+                            .arg(a.name().toString(), reader.name().toString()).arg(limits.maxAttributeLength));
+                        break;
+                    }
+                }
+                if (reader.hasError()) break;
+            }
+            if (visit(reader)) continue;
+        }
+        else if (reader.isEndElement()) {
+            --depth;
+        }
+        reader.readNext();
+    }
+    return !reader.hasError();
+}
+
+int ParamsEditor::pasteMimeData(const QMimeData* mime) {
+    if (!mime) return 0;
+    QVector<ParamBase*> targets;
+    QVariantList oldValues, newValues;
+
+    if (mime->hasFormat(mimeType())) {
+        const QByteArray raw = qUncompress(mime->data(mimeType()));
+        QDataStream in(raw);
+        in.setVersion(QDataStream::Qt_5_15);
+        quint32 magic = 0, count = 0;
+        quint16 version = 0;
+        in >> magic >> version >> count;
+        if (magic != ClipboardMagic || version != ClipboardVersion) return 0;
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            QString name;
+            QVariant v;
+            in >> name >> v;
+            if (in.status() != QDataStream::Ok) break;
+            for (ParamBase* param : paramIndex.values(name)) {
+                targets.append(param);
+                oldValues.append(param->value());
+                newValues.append(v);
+            }
+        }
+        if (targets.isEmpty()) return 0;
+        undo->push(new ParamValuesCommand("Paste", tabs, targets, oldValues, newValues));
+    }
+    else if (mime->hasText()) {
+        const QString text = mime->text();
+        if (limits.maxFileSize > 0 && text.size() > limits.maxFileSize) return 0;
+        QXmlStreamReader reader(text);
+        tabs->setUpdatesEnabled(false);
+        readParamElements(reader, limits, [&](QXmlStreamReader& r) {
+            const qint64 at = r.characterOffset();
+            const QList<ParamBase*> matches = paramIndex.values(r.name().toString());
+            for (ParamBase* param : matches) {
+                if (!atStartElement(r, at)) break;
+                QVariant before = param->value();
+                param->load(r);
+                targets.append(param);
+                oldValues.append(before);
+                newValues.append(param->value());
+            }
+            return !matches.isEmpty();
+        });
+        tabs->setUpdatesEnabled(true);
+        if (targets.isEmpty()) return 0;
+        undo->push(new ParamValuesCommand("Paste", tabs, targets, oldValues, newValues, true));
+    }
+    return targets.size();
+}
+
+void ParamsEditor::copyParams(const QVector<ParamBase*>& params) {
+    if (!params.isEmpty())
+        QApplication::clipboard()->setMimeData(createMimeData(params));
+}
+
+void ParamsEditor::copyTab(int tabIndex) { copyParams(params(tabIndex)); }
+
+void ParamsEditor::copySelection() {
+    const int index = tabs->currentIndex();
+    if (index < 0 || index >= pages.size()) return;
+    const QVector<ParamBase*> selected = pages[index]->selectedParams();
+    copyParams(selected.isEmpty() ? allParams[index] : selected);
+}
+
+int ParamsEditor::paste() { return pasteMimeData(QApplication::clipboard()->mimeData()); }
+
+void ParamsEditor::setMainHelp(const QString& htmlText) {
+    if (!helpTabCreated) {
+        helpBrowser = new QTextBrowser(this);
+        QWidget* helpTab = new QWidget;
+        QVBoxLayout* helpLayout = new QVBoxLayout(helpTab);
+        helpLayout->addWidget(helpBrowser);
+        tabs->addTab(helpTab, QIcon(), "Help");
+        helpTabCreated = true;
+    }
+    helpBrowser->setHtml(htmlText);
+}
+
+bool ParamsEditor::loadFromFile(const QString& filename) {
+    return loadFromFile(filename, 0, QFileInfo(filename).canonicalPath());
+}
+
+bool ParamsEditor::loadFromData(const QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return loadFromDevice(&buffer, QString(), 0, QString());
+}
+
+bool ParamsEditor::saveToFile(const QString& filename) {
+    lastSaveError.clear();
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        lastSaveError = QString("%1: %2").arg(filename, file.errorString());
+        qWarning() << "Cannot save" << lastSaveError;
+        return false;
+    }
+    QXmlStreamWriter writer(&file);
+    writer.setAutoFormatting(true);
+    writer.writeStartDocument();
+    writer.writeStartElement("Params");
+    for (const auto& tab : allParams)
+        for (const auto* param : tab)
+            param->save(writer);
+    writer.writeEndElement();
+    writer.writeEndDocument();
+    // A file loadFromFile() would reject replaces nothing: the previous file stays
+    if (writer.hasError())
+        lastSaveError = QString("%1: %2").arg(filename, file.errorString());
+    else if (limits.maxFileSize > 0 && file.size() > limits.maxFileSize)
+        lastSaveError = QString("%1: larger than %2 bytes").arg(filename).arg(limits.maxFileSize);
+    if (!lastSaveError.isEmpty()) {
+        file.cancelWriting();
+        qWarning() << "Cannot save" << lastSaveError;
+        return false;
+    }
+    if (!file.commit()) {
+        lastSaveError = QString("%1: %2").arg(filename, file.errorString());
+        qWarning() << "Cannot save" << lastSaveError;
+        return false;
+    }
+    return true;
+}
+
+bool ParamsEditor::loadFromFile(const QString& filename, int depth, const QString& topDir) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        lastLoadError = QString("%1: %2").arg(filename, file.errorString());
+        qWarning() << "Cannot load" << lastLoadError;
+        return false;
+    }
+    return loadFromDevice(&file, filename, depth, topDir);
+}
+
+/**
+ * @brief Check that a base file named by a parameter file lies inside a directory.
+ * @param base Value of the "base" attribute.
+ * @param filename File naming the base.
+ * @param topDir Canonical directory the base must be in.
+ * @return The path of the base, or an empty string if it is absolute or outside topDir.
+ */
+static QString confinedBasePath(const QString& base, const QString& filename, const QString& topDir) {
+    if (topDir.isEmpty() || QDir::isAbsolutePath(base)) return QString();
+    const QString prefix = topDir.endsWith(QLatin1Char('/')) ? topDir : topDir + QLatin1Char('/');
+    // Canonical: ".." and symbolic links cannot lead out; a missing file fails here too
+    const QString canonical = QFileInfo(QFileInfo(filename).dir().filePath(base)).canonicalFilePath();
+    if (canonical.isEmpty() || !canonical.startsWith(prefix)) return QString();
+    return canonical;
+}
+
+bool ParamsEditor::loadFromDevice(QIODevice* device, const QString& filename, int depth, const QString& topDir) {
+    const QString source = filename.isEmpty() ? QString("data") : filename;
+    lastLoadError.clear();
+    if (limits.maxFileSize > 0 && device->size() > limits.maxFileSize) {
+        lastLoadError = QString("%1: larger than %2 bytes").arg(source).arg(limits.maxFileSize);
+        qWarning() << "Cannot load" << lastLoadError;
+        return false;
+    }
+    QXmlStreamReader reader(device);
+    bool root = true;
+    bool baseLoaded = true;
+    const bool ok = readParamElements(reader, limits, [&](QXmlStreamReader& r) {
+        if (root) {
+            root = false;
+            const QString base = r.attributes().value("base").toString();
+            if (!base.isEmpty() && !filename.isEmpty() && depth < 8) {
+                const QString path = confinedBasePath(base, filename, topDir);
+                if (path.isEmpty()) {
+                    r.raiseError(QString("base file %1 is not inside %2").arg(base, QDir::toNativeSeparators(topDir)));
+                }
+                else {
+                    baseLoaded = loadFromFile(path, depth + 1, topDir);
+                    if (!baseLoaded) r.raiseError(QString("base file %1 rejected").arg(base));
+                }
+            }
+            return false;
+        }
+        // Each load() reads one token: stop once the reader has left this element
+        const qint64 at = r.characterOffset();
+        const QList<ParamBase*> targets = paramIndex.values(r.name().toString());
+        for (ParamBase* param : targets) {
+            if (!atStartElement(r, at)) break;
+            param->load(r);
+        }
+        return !targets.isEmpty();
+    });
+    // A rejected base has already reported the more specific reason
+    if (!ok && baseLoaded) {
+        lastLoadError = QString("%1:%2: %3").arg(source).arg(reader.lineNumber()).arg(reader.errorString());
+        qWarning() << "Cannot load" << lastLoadError;
+    }
+    return ok;
+}
+
+void ParamsEditor::show(const QString& windowTitle, const QIcon& icon) {
+    setWindowTitle(windowTitle);
+    setWindowIcon(icon);
+    if (tabs->count() > 1) {
+        tabs->setCurrentIndex(0);
+    }
+    QDialog::show();
+}
+
+void ParamsEditor::showContextMenu(int tabIndex, const QPoint& globalPos) {
+    QMenu menu(this);
+    QAction* copySelected = menu.addAction("Copy selected");
+    copySelected->setEnabled(!pages[tabIndex]->selectedParams().isEmpty());
+    QAction* copyAll = menu.addAction("Copy tab");
+    QAction* pasteAction = menu.addAction("Paste");
+    const QMimeData* mime = QApplication::clipboard()->mimeData();
+    pasteAction->setEnabled(mime && (mime->hasFormat(mimeType()) || mime->hasText()));
+    menu.addSeparator();
+    QAction* undoAction = menu.addAction("Undo");
+    undoAction->setEnabled(undo->canUndo());
+    QAction* redoAction = menu.addAction("Redo");
+    redoAction->setEnabled(undo->canRedo());
+
+    QStringList dimensions;
+    for (ParamBase* param : allParams[tabIndex])
+        if (!param->unitDimension().isEmpty() && !dimensions.contains(param->unitDimension()))
+            dimensions << param->unitDimension();
+    if (!dimensions.isEmpty()) {
+        menu.addSeparator();
+        QMenu* unitsMenu = menu.addMenu("Units");
+        for (const QString& dimension : dimensions) {
+            const QStringList units = ParamUnits::instance().units(dimension);
+            const QString current = displayUnits.contains(dimension)
+                ? displayUnits.value(dimension).unit : units.value(0);
+            QMenu* dimensionMenu = unitsMenu->addMenu(dimension);
+            for (const QString& unit : units) {
+                QAction* action = dimensionMenu->addAction(unit);
+                action->setCheckable(true);
+                action->setChecked(unit == current);
+                connect(action, &QAction::triggered, this, [this, dimension, unit]() { setDisplayUnit(dimension, unit); });
+            }
+        }
+    }
+
+    QAction* chosen = menu.exec(globalPos);
+    if (chosen == copySelected) copyParams(pages[tabIndex]->selectedParams());
+    else if (chosen == copyAll) copyTab(tabIndex);
+    else if (chosen == pasteAction) paste();
+    else if (chosen == undoAction) undo->undo();
+    else if (chosen == redoAction) undo->redo();
+}
+
+void ParamsEditor::onApplyClicked() {
+    if (applyAll())
+        accept();
+}
+
+void ParamsEditor::applyParam(int tab, ParamBase* param) {
+    if (auditLog && editedParams.contains(param)) {
+        const QVariant before = param->storedValue();
+        param->apply();
+        const QVariant after = param->storedValue();
+        if (before != after) {
+            const QString name = tabTitle(tab) + QLatin1Char('/') + param->name;
+            // A password is logged as changed, never in clear
+            if (qobject_cast<PasswordParam*>(param))
+                auditLog->record(name, QStringLiteral("***"), QStringLiteral("***"));
+            else
+                auditLog->record(name, before, after);
+        }
+    }
+    else {
+        param->apply();
+    }
+    ParamLatency::record(param, ParamLatency::Apply);
+    emit param->applied();
+    ParamLatency::record(param, ParamLatency::Publish);
+}
+
+void ParamsEditor::setParamValid(ParamBase* param, bool valid) {
+    const int before = invalidParams.size();
+    if (valid) invalidParams.remove(param);
+    else invalidParams.insert(param);
+    if (before == invalidParams.size()) return;
+    applyBtn->setEnabled(invalidParams.isEmpty());
+    QStringList names;
+    for (ParamBase* p : qAsConst(invalidParams))
+        names << p->name;
+    applyBtn->setToolTip(names.isEmpty() ? QString() : "Invalid: " + names.join(", "));
+}
+
+void ParamsEditor::onCancelClicked() {
+    reject();
+}
+
+/* -------------------------------------
+   Parameter Sweep Generator
+   ------------------------------------- */
+
+void ParamSweep::setCount(int n) { count = qMax(0, n); }
+
+void ParamSweep::addRange(DoubleParam* param, double from, double to, int levels) {
+    addAxis(param->name, "value", false, param->minimum(), param->maximum(), from, to, levels, QVector<double>());
+}
+
+void ParamSweep::addRange(IntParam* param, int from, int to, int levels) {
+    addAxis(param->name, "value", true, param->minimum(), param->maximum(), from, to, levels, QVector<double>());
+}
+
+void ParamSweep::addRange(RangeParam* param, RangeBound bound, double from, double to, int levels) {
+    addRangeBound(param, bound);
+    addAxis(param->name, bound == Lower ? "min" : "max", false, param->minimum(), param->maximum(), from, to, levels, QVector<double>());
+}
+
+void ParamSweep::addValues(DoubleParam* param, const QVector<double>& values) {
+    addAxis(param->name, "value", false, param->minimum(), param->maximum(), 0, 0, 0, values);
+}
+
+void ParamSweep::addValues(IntParam* param, const QVector<int>& values) {
+    QVector<double> v;
+    v.reserve(values.size());
+    for (int i : values) v.append(i);
+    addAxis(param->name, "value", true, param->minimum(), param->maximum(), 0, 0, 0, v);
+}
+
+void ParamSweep::addValues(RangeParam* param, RangeBound bound, const QVector<double>& values) {
+    addRangeBound(param, bound);
+    addAxis(param->name, bound == Lower ? "min" : "max", false, param->minimum(), param->maximum(), 0, 0, 0, values);
+}
+
+qint64 ParamSweep::variantCount() const {
+    if (axes.isEmpty()) return 0;
+    if (sampling != Grid) return count;
+    qint64 total = 1;
+    for (const Axis& axis : axes) {
+        const qint64 levels = gridLevels(axis);
+        if (levels <= 0) return 0;
+        if (total > std::numeric_limits<qint64>::max() / levels) return std::numeric_limits<qint64>::max();
+        total *= levels;
+    }
+    return total;
+}
+
+int ParamSweep::run(const QString& directory, QString* error) {
+    const qint64 variants = variantCount();
+    if (variants <= 0 || variants > MaxVariants) {
+        if (error) *error = variants <= 0 ? QString("No variants to generate")
+            : QString("%1 variants exceed the limit of %2").arg(variants).arg(int(MaxVariants));
+        return -1;
+    }
+    const int total = int(variants);
+    QDir dir(directory);
+    if (!dir.mkpath(".")) {
+        if (error) *error = QString("Cannot create %1").arg(directory);
+        return -1;
+    }
+    if (!editor->saveToFile(dir.filePath("base.xml"))) {
+        if (error) *error = editor->saveError();
+        return -1;
+    }
+
+    // Per-axis strides for the grid and permutations for the hypercube
+    QVector<qint64> strides(axes.size(), 1);
+    for (int a = 1; a < axes.size(); ++a)
+        strides[a] = strides[a - 1] * gridLevels(axes[a - 1]);
+    QVector<QVector<quint32>> strata;
+    if (sampling == LatinHypercube) {
+        std::mt19937_64 rng(seed);
+        strata.resize(axes.size());
+        for (QVector<quint32>& perm : strata) {
+            perm.resize(total);
+            for (int i = 0; i < total; ++i) perm[i] = quint32(i);
+            std::shuffle(perm.begin(), perm.end(), rng);
+        }
+    }
+
+    const int chunks = qMin(total, QThread::idealThreadCount() * 8);
+    QVector<QByteArray> manifest(chunks);
+    std::atomic<int> written{ 0 };
+    std::atomic<int> failed{ 0 };
+    QThreadPool pool;
+    pool.setMaxThreadCount(QThread::idealThreadCount());
+    for (int c = 0; c < chunks; ++c) {
+        const int first = int(qint64(total) * c / chunks);
+        const int last = int(qint64(total) * (c + 1) / chunks);
+        QByteArray* rows = &manifest[c];
+        pool.start(QRunnable::create([&, first, last, rows]() {
+            QVector<double> sample(axes.size());
+            QByteArray buffer;
+            for (int v = first; v < last; ++v) {
+                for (int a = 0; a < axes.size(); ++a)
+                    sample[a] = sampleValue(a, v, total, strides, strata);
+                buffer.clear();
+                writeVariant(buffer, v, sample);
+                QFile file(dir.filePath(QString("variant_%1.xml").arg(v, 6, 10, QLatin1Char('0'))));
+                if (file.open(QIODevice::WriteOnly) && file.write(buffer) == buffer.size())
+                    written.fetch_add(1, std::memory_order_relaxed);
+                else
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                rows->append(QByteArray::number(v));
+                for (double value : sample)
+                    rows->append(',').append(QByteArray::number(value, 'g', 12));
+                rows->append('\n');
+            }
+            }));
+    }
+    pool.waitForDone();
+
+    QFile csv(dir.filePath("manifest.csv"));
+    if (csv.open(QIODevice::WriteOnly)) {
+        QByteArray header = "variant";
+        for (const Axis& axis : axes)
+            header += ',' + axis.element.toUtf8() + '.' + axis.attribute.toUtf8();
+        csv.write(header + '\n');
+        for (const QByteArray& rows : qAsConst(manifest))
+            csv.write(rows);
+    }
+    if (failed.load() > 0) {
+        if (error) *error = QString("%1 variant files could not be written").arg(failed.load());
+        return -1;
+    }
+    return written.load();
+}
+
+void ParamSweep::addAxis(const QString& element, const QString& attribute, bool integer,
+    double widgetMin, double widgetMax, double from, double to, int levels, const QVector<double>& values) {
+    Axis axis;
+    axis.element = element;
+    axis.attribute = attribute;
+    axis.integer = integer;
+    axis.lo = qBound(widgetMin, qMin(from, to), widgetMax);
+    axis.hi = qBound(widgetMin, qMax(from, to), widgetMax);
+    axis.levels = levels;
+    for (double v : values)
+        axis.values.append(qBound(widgetMin, integer ? std::round(v) : v, widgetMax));
+    axes.append(axis);
+}
+
+void ParamSweep::addRangeBound(RangeParam* param, RangeBound bound) {
+    for (int i = 0; i < fixed.size(); ++i) {
+        if (fixed[i].element == param->name && fixed[i].attribute == (bound == Lower ? "min" : "max")) {
+            fixed.remove(i);
+            return;
+        }
+    }
+    for (const Axis& axis : qAsConst(axes))
+        if (axis.element == param->name) return; // Other bound already swept
+    const QVariantList range = param->value().toList();
+    Fixed other;
+    other.element = param->name;
+    other.attribute = bound == Lower ? "max" : "min";
+    other.value = QString::number(range.value(bound == Lower ? 1 : 0).toDouble(), 'g', 12);
+    fixed.append(other);
+}
+
+qint64 ParamSweep::gridLevels(const Axis& axis) {
+    if (!axis.values.isEmpty()) return axis.values.size();
+    if (axis.levels > 0) return axis.levels;
+    // Exact: the bounds are integers well within the 53 bits of a double
+    return axis.integer ? qint64(axis.hi - axis.lo) + 1 : 2;
+}
+
+double ParamSweep::valueAt(const Axis& axis, double u) {
+    if (!axis.values.isEmpty())
+        return axis.values[qMin(int(u * axis.values.size()), axis.values.size() - 1)];
+    const double v = axis.lo + u * (axis.hi - axis.lo);
+    return axis.integer ? qBound(axis.lo, std::floor(axis.lo + u * (axis.hi - axis.lo + 1)), axis.hi) : v;
+}
+
+double ParamSweep::unit(int variant, int axis) const {
+    quint64 z = seed + (quint64(variant) * quint64(axes.size()) + quint64(axis) + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return double(z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double ParamSweep::sampleValue(int a, int variant, int total, const QVector<qint64>& strides,
+    const QVector<QVector<quint32>>& strata) const {
+    const Axis& axis = axes[a];
+    switch (sampling) {
+    case Grid: {
+        const qint64 levels = gridLevels(axis);
+        const qint64 k = (variant / strides[a]) % levels;
+        if (!axis.values.isEmpty()) return axis.values[int(k)];
+        if (levels == 1) return axis.integer ? std::round((axis.lo + axis.hi) / 2) : (axis.lo + axis.hi) / 2;
+        const double v = axis.lo + k * (axis.hi - axis.lo) / (levels - 1);
+        return axis.integer ? std::round(v) : v;
+    }
+    case Random:
+        return valueAt(axis, unit(variant, a));
+    case LatinHypercube:
+        return valueAt(axis, (strata[a][variant] + unit(variant, a)) / total);
+    }
+    return axis.lo;
+}
+
+void ParamSweep::writeVariant(QByteArray& buffer, int variant, const QVector<double>& sample) const {
+    QXmlStreamWriter w(&buffer);
+    w.setAutoFormatting(true);
+    w.writeStartDocument();
+    w.writeStartElement("Params");
+    w.writeAttribute("base", "base.xml");
+    w.writeAttribute("variant", QString::number(variant));
+    QSet<QString> done;
+    for (int a = 0; a < axes.size(); ++a) {
+        const QString& element = axes[a].element;
+        if (done.contains(element)) continue;
+        done.insert(element);
+        w.writeStartElement(element);
+        for (const Fixed& f : fixed)
+            if (f.element == element)
+                w.writeAttribute(f.attribute, f.value);
+        for (int b = a; b < axes.size(); ++b) {
+            if (axes[b].element != element) continue;
+            w.writeAttribute(axes[b].attribute, axes[b].integer
+                ? QString::number(qint64(sample[b])) : QString::number(sample[b], 'g', 12));
+        }
+        w.writeEndElement();
+    }
+    w.writeEndElement();
+    w.writeEndDocument();
+}
+
+/* -------------------------------------
+   QSettings Persistence Backend
+   ------------------------------------- */
+
+ParamsSettingsBackend::ParamsSettingsBackend(ParamsEditor* editor, QSettings* settings, QObject* parent)
+    : QObject(parent ? parent : editor), editor(editor), settings(settings) {
+    attach();
+}
+
+ParamsSettingsBackend::ParamsSettingsBackend(ParamsEditor* editor, const QString& iniFile, QObject* parent)
+    : QObject(parent ? parent : editor), editor(editor) {
+    settings = new QSettings(iniFile, QSettings::IniFormat, this);
+    attach();
+}
+
+bool ParamsSettingsBackend::isDirty(ParamBase* param) const { return dirty.contains(param); }
+
+void ParamsSettingsBackend::readAll() {
+    const QList<ParamBase*> pending = unread.values();
+    for (ParamBase* param : pending)
+        read(param);
+}
+
+void ParamsSettingsBackend::reload() {
+    dirty.clear();
+    for (auto it = keys.cbegin(); it != keys.cend(); ++it)
+        unread.insert(it.key());
+    for (auto it = keys.cbegin(); it != keys.cend(); ++it)
+        if (ParamsEditor::isRealized(it.key()))
+            read(it.key());
+}
+
+bool ParamsSettingsBackend::writeDirty() {
+    if (dirty.isEmpty()) return true;
+    for (ParamBase* param : qAsConst(dirty)) {
+        QVariant v = param->value();
+        if (v.isValid())
+            settings->setValue(keys.value(param), v);
+    }
+    dirty.clear();
+    settings->sync();
+    return settings->status() == QSettings::NoError;
+}
+
+void ParamsSettingsBackend::attach() {
+    for (int tab = 0; tab < editor->tabCount(); ++tab)
+        for (ParamBase* param : editor->params(tab))
+            track(tab, param);
+    connect(editor, &ParamsEditor::paramAdded, this, &ParamsSettingsBackend::track);
+    connect(editor, &ParamsEditor::paramRealized, this, [this](ParamBase* param) {
+        if (unread.contains(param))
+            read(param);
+        });
+    connect(editor, &ParamsEditor::applying, this, &ParamsSettingsBackend::readAll);
+    connect(editor, &ParamsEditor::applied, this, &ParamsSettingsBackend::writeDirty);
+}
+
+void ParamsSettingsBackend::track(int tab, ParamBase* param) {
+    keys.insert(param, keyName(editor->tabTitle(tab)) + QLatin1Char('/') + keyName(param->name));
+    unread.insert(param);
+    connect(param, &ParamBase::changed, this, [this, param]() {
+        if (!reading)
+            dirty.insert(param);
+        });
+    connect(param, &QObject::destroyed, this, [this, param]() {
+        keys.remove(param);
+        dirty.remove(param);
+        unread.remove(param);
+        });
+    if (ParamsEditor::isRealized(param))
+        read(param);
+}
+
+void ParamsSettingsBackend::read(ParamBase* param) {
+    unread.remove(param);
+    if (dirty.contains(param)) return; // Keep user edits made before the key was read
+    const QVariant v = settings->value(keys.value(param));
+    if (!v.isValid()) return;
+    reading = true;
+    param->setValue(v);
+    reading = false;
+}
+
+QString ParamsSettingsBackend::keyName(QString name) {
+    name.replace(QLatin1Char('/'), QLatin1Char('_'));
+    name.replace(QLatin1Char('\\'), QLatin1Char('_'));
+    return name;
+}
+
+/* -------------------------------------
+   Property Binding System
+   ------------------------------------- */
+
+void AdvancedPropertyAdapter::bindObjectToEditor(
+    ParamsEditor* editor,
+    QObject* obj,
+    const QString& defaultTabName) {
+    const QMetaObject* meta = obj->metaObject();
+    const ClassMetadata& cls = classMetadata(meta);
+    const QList<QByteArray> dynamicList = obj->dynamicPropertyNames();
+    const QSet<QByteArray> dynamicNames(dynamicList.begin(), dynamicList.end());
+    QMap<QString, int> categoryToTabIndex;
+
+    // Create tabs based on categories
+    for (int i = 0; i < meta->propertyCount(); ++i) {
+        QMetaProperty prop = meta->property(i);
+        if (!prop.isWritable()) continue;
+
+        PropertyInfo info = extractPropertyInfo(obj, prop, cls, dynamicNames);
+        QString category = info.category.isEmpty() ? defaultTabName : info.category;
+
+        if (!categoryToTabIndex.contains(category)) {
+            int tabIndex = editor->addTab(category);
+            categoryToTabIndex[category] = tabIndex;
+        }
+
+        createParamForProperty(editor, categoryToTabIndex[category], obj, prop, info);
+    }
+
+    // Connessione per salvare i valori
+    QObject::connect(editor, &ParamsEditor::accepted, [obj]() {
+        qDebug() << "Properties updated";
+        });
+}
+
+void AdvancedPropertyAdapter::registerMetadata(const QMetaObject* meta, const QString& property, const PropertyInfo& info) {
+    PropertyInfo& entry = registry()[meta][property];
+    entry = info;
+    entry.name = property;
+    // Subclasses inherit the registration: drop every parsed class, not just this one
+    metadataCache().clear();
+}
+
+const AdvancedPropertyAdapter::ClassMetadata& AdvancedPropertyAdapter::classMetadata(const QMetaObject* meta) {
+    QHash<const QMetaObject*, ClassMetadata>& cache = metadataCache();
+    auto it = cache.find(meta);
+    if (it != cache.end()) return *it;
+
+    ClassMetadata cls;
+    for (int i = 0; i < meta->propertyCount(); ++i)
+        cls.declared.insert(QByteArray(meta->property(i).name()));
+
+    // Q_CLASSINFO("widthMin", "0"): the key is the property name followed by one of the suffixes
+    static const char* const suffixes[] = { "Display", "Tooltip", "Category", "Min", "Max", "Step" };
+    for (int i = 0; i < meta->classInfoCount(); ++i) {
+        const QMetaClassInfo classInfo = meta->classInfo(i);
+        const QByteArray key(classInfo.name());
+        for (int s = 0; s < 6; ++s) {
+            if (!key.endsWith(suffixes[s]) || key.size() == int(qstrlen(suffixes[s]))) continue;
+            const QString property = QString::fromUtf8(key.left(key.size() - int(qstrlen(suffixes[s]))));
+            const QString value = QString::fromUtf8(classInfo.value());
+            PropertyInfo& info = cls.properties[property];
+            info.name = property;
+            switch (s) {
+            case 0: info.displayName = value; break;
+            case 1: info.tooltip = value; break;
+            case 2: info.category = value; break;
+            case 3: info.min = value.toDouble(); break;
+            case 4: info.max = value.toDouble(); break;
+            default: info.step = value.toDouble(); break;
+            }
+            break;
+        }
+    }
+
+    // Registrations of the base classes first, so the most derived one wins
+    QVector<const QMetaObject*> chain;
+    for (const QMetaObject* m = meta; m; m = m->superClass()) chain.prepend(m);
+    const QHash<const QMetaObject*, QHash<QString, PropertyInfo>>& registered = registry();
+    for (const QMetaObject* m : chain) {
+        const auto r = registered.constFind(m);
+        if (r == registered.constEnd()) continue;
+        for (auto p = r->cbegin(); p != r->cend(); ++p)
+            cls.properties.insert(p.key(), p.value());
+    }
+
+    return *cache.insert(meta, cls);
+}
+
+QHash<const QMetaObject*, AdvancedPropertyAdapter::ClassMetadata>& AdvancedPropertyAdapter::metadataCache() {
+    static QHash<const QMetaObject*, ClassMetadata> cache;
+    return cache;
+}
+
+QHash<const QMetaObject*, QHash<QString, AdvancedPropertyAdapter::PropertyInfo>>& AdvancedPropertyAdapter::registry() {
+    static QHash<const QMetaObject*, QHash<QString, PropertyInfo>> entries;
+    return entries;
+}
+
+AdvancedPropertyAdapter::PropertyInfo AdvancedPropertyAdapter::extractPropertyInfo(QObject* obj, QMetaProperty prop,
+    const ClassMetadata& cls, const QSet<QByteArray>& dynamicNames) {
+    PropertyInfo info = cls.properties.value(QString::fromUtf8(prop.name()));
+    info.name = QString::fromUtf8(prop.name());
+
+    // Rimuovi il prefisso 'm_' per il nome visualizzato
+    if (info.displayName.isEmpty()) {
+        QString cleanName = info.name;
+        if (cleanName.startsWith("m_")) {
+            cleanName = cleanName.mid(2);
+        }
+        cleanName.replace('_', ' ');
+        info.displayName = cleanName;
+    }
+
+    // Override per oggetto: solo le proprietà che esistono davvero vengono lette
+    auto override = [&](const char* suffix) {
+        const QByteArray key = QByteArray(prop.name()) + suffix;
+        return dynamicNames.contains(key) || cls.declared.contains(key) ? obj->property(key) : QVariant();
+    };
+    QVariant v;
+    if ((v = override("Display")).isValid()) info.displayName = v.toString();
+    if ((v = override("Tooltip")).isValid()) info.tooltip = v.toString();
+    if ((v = override("Category")).isValid()) info.category = v.toString();
+    if ((v = override("Min")).isValid()) info.min = v.toDouble();
+    if ((v = override("Max")).isValid()) info.max = v.toDouble();
+    if ((v = override("Step")).isValid()) info.step = v.toDouble();
+
+    // Gestione enumerazioni
+    if (prop.isEnumType() && info.enumNames.isEmpty()) {
+        QMetaEnum e = prop.enumerator();
+        for (int j = 0; j < e.keyCount(); j++) {
+            info.enumNames << e.key(j);
+        }
+    }
+
+    return info;
+}
+
+void AdvancedPropertyAdapter::createParamForProperty(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    int type = prop.userType();
+
+    if (type == QMetaType::Int) {
+        createIntParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::Double) {
+        createDoubleParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::Float) {
+        createFloatParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::Bool) {
+        createBoolParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QString) {
+        createStringParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QColor) {
+        createColorParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QStringList) {
+        createStringListParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QDate) {
+        createDateParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QTime) {
+        createTimeParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QPoint) {
+        createPointParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QSize) {
+        createSizeParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QRect) {
+        createRectParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (type == QMetaType::QVariant) {
+        createVariantParam(editor, tabIndex, obj, prop, info);
+    }
+    else if (prop.isEnumType()) {
+        createEnumParam(editor, tabIndex, obj, prop, info);
+    }
+    else {
+        qWarning() << "Unsupported type:" << prop.typeName() << "for property" << info.name;
+    }
+}
+
+void AdvancedPropertyAdapter::createIntParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    int* valuePtr = new int(prop.read(obj).toInt());
+    int min = (info.min != 0 || info.max != 0) ? info.min : INT_MIN;
+    int max = (info.min != 0 || info.max != 0) ? info.max : INT_MAX;
+    int step = info.step != 0 ? info.step : 1;
+
+    IntParam* param = new IntParam(
+        info.displayName,
+        valuePtr,
+        min, max, step,
+        info.tooltip
+    );
+
+    setupParamConnections<IntParam, int>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createDoubleParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    double* valuePtr = new double(prop.read(obj).toDouble());
+    double min = (info.min != 0 || info.max != 0) ? info.min : -DBL_MAX;
+    double max = (info.min != 0 || info.max != 0) ? info.max : DBL_MAX;
+    double step = info.step != 0 ? info.step : 0.1;
+
+    DoubleParam* param = new DoubleParam(
+        info.displayName,
+        valuePtr,
+        min, max, step,
+        info.tooltip
+    );
+
+    setupParamConnections<DoubleParam, double>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createFloatParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    float* valuePtr = new float(prop.read(obj).toFloat());
+    float min = (info.min != 0 || info.max != 0) ? static_cast<float>(info.min) : -FLT_MAX;
+    float max = (info.min != 0 || info.max != 0) ? static_cast<float>(info.max) : FLT_MAX;
+    float step = info.step != 0 ? static_cast<float>(info.step) : 0.1f;
+
+    FloatParam* param = new FloatParam(
+        info.displayName,
+        valuePtr,
+        min, max, step,
+        info.tooltip
+    );
+
+    setupParamConnections<FloatParam, float>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createBoolParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    bool* valuePtr = new bool(prop.read(obj).toBool());
+    bool defVal = *valuePtr;
+
+    BoolParam* param = new BoolParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<BoolParam, bool>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createStringParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QString* valuePtr = new QString(prop.read(obj).toString());
+    QString defVal = *valuePtr;
+
+    StringParam* param = new StringParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        Qt::ImhNone,
+        info.tooltip
+    );
+
+    setupParamConnections<StringParam, QString>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createColorParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QColor* valuePtr = new QColor(prop.read(obj).value<QColor>());
+    QColor defVal = *valuePtr;
+
+    ColorParam* param = new ColorParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<ColorParam, QColor>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createStringListParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QStringList* valuePtr = new QStringList(prop.read(obj).toStringList());
+    QStringList defVal = *valuePtr;
+
+    StringListParam* param = new StringListParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<StringListParam, QStringList>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createDateParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QDate* valuePtr = new QDate(prop.read(obj).toDate());
+    QDate defVal = *valuePtr;
+
+    DateParam* param = new DateParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<DateParam, QDate>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createTimeParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QTime* valuePtr = new QTime(prop.read(obj).toTime());
+    QTime defVal = *valuePtr;
+
+    TimeParam* param = new TimeParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<TimeParam, QTime>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createPointParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QPoint* valuePtr = new QPoint(prop.read(obj).toPoint());
+    QPoint defVal = *valuePtr;
+
+    PointParam* param = new PointParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<PointParam, QPoint>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createSizeParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QSize* valuePtr = new QSize(prop.read(obj).toSize());
+    QSize defVal = *valuePtr;
+
+    SizeParam* param = new SizeParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<SizeParam, QSize>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createRectParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QRect* valuePtr = new QRect(prop.read(obj).toRect());
+    QRect defVal = *valuePtr;
+
+    RectParam* param = new RectParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<RectParam, QRect>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createVariantParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    QVariant* valuePtr = new QVariant(prop.read(obj));
+    QVariant defVal = *valuePtr;
+
+    VariantParam* param = new VariantParam(
+        info.displayName,
+        valuePtr,
+        defVal,
+        info.tooltip
+    );
+
+    setupParamConnections<VariantParam, QVariant>(editor, tabIndex, param, obj, prop, valuePtr);
+}
+
+void AdvancedPropertyAdapter::createEnumParam(
+    ParamsEditor* editor,
+    int tabIndex,
+    QObject* obj,
+    QMetaProperty prop,
+    const PropertyInfo& info) {
+    int* valuePtr = new int(prop.read(obj).toInt());
+    QStringList* options = new QStringList(info.enumNames);
+    int defIndex = *valuePtr;
+
+    ComboParam* param = new ComboParam(
+        info.displayName,
+        options,
+        valuePtr,
+        defIndex,
+        info.tooltip
+    );
+
+    QObject::connect(param, &ComboParam::destroyed, [valuePtr, options]() {
+        delete valuePtr;
+        delete options;
+        });
+
+    QComboBox* combo = static_cast<QComboBox*>(param->widget);
+    QObject::connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+        [obj, prop, valuePtr](int index) {
+            *valuePtr = index;
+            prop.write(obj, *valuePtr);
+        });
+
+    editor->addParam(tabIndex, param);
+}
@@ -23,6 +23,12 @@
 /**
  * @file parameditor.h
  * @brief A Qt-based parameter editor dialog for managing various parameter types.
+ *
+ * Declarations only: the implementation and the moc output are compiled once in
+ * the parameditor library (parameditor.cpp), so including this header does not
+ * pull in QtWidgets as a whole. Models, delegates, caches, queues and worker
+ * threads used only by the implementation are declared in parameditor_p.h and
+ * held here through forward declarations.
  * @author Manuele Turini
  * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
  */
@@ -30,14 +36,344 @@
 #ifndef PARAMEDITOR_H
 #define PARAMEDITOR_H
 
-#include <QtWidgets>
-#include <QObject>
+#include <QColor>
+#include <QDateTime>
+#include <QDialog>
+#include <QDoubleSpinBox>
+#include <QElapsedTimer>
+#include <QFont>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
 #include <QMetaProperty>
-#include <QMetaEnum>
-#include <QDebug>
-#include <QMap>
-#include <climits>
-#include <cfloat>
+#include <QPainterPath>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QSet>
+#include <QSpinBox>
+#include <QVariant>
+#include <QVector>
+#include <QWidget>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Used only through pointers and references; parameditor.cpp includes the full headers.
+QT_FORWARD_DECLARE_CLASS(QCheckBox)
+QT_FORWARD_DECLARE_CLASS(QComboBox)
+QT_FORWARD_DECLARE_CLASS(QContextMenuEvent)
+QT_FORWARD_DECLARE_CLASS(QDataStream)
+QT_FORWARD_DECLARE_CLASS(QDateEdit)
+QT_FORWARD_DECLARE_CLASS(QDateTimeEdit)
+QT_FORWARD_DECLARE_CLASS(QFile)
+QT_FORWARD_DECLARE_CLASS(QFocusEvent)
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+QT_FORWARD_DECLARE_CLASS(QKeyEvent)
+QT_FORWARD_DECLARE_CLASS(QLabel)
+QT_FORWARD_DECLARE_CLASS(QLineEdit)
+QT_FORWARD_DECLARE_CLASS(QMimeData)
+QT_FORWARD_DECLARE_CLASS(QMouseEvent)
+QT_FORWARD_DECLARE_CLASS(QPaintEvent)
+QT_FORWARD_DECLARE_CLASS(QPushButton)
+QT_FORWARD_DECLARE_CLASS(QResizeEvent)
+QT_FORWARD_DECLARE_CLASS(QSettings)
+QT_FORWARD_DECLARE_CLASS(QShowEvent)
+QT_FORWARD_DECLARE_CLASS(QSlider)
+QT_FORWARD_DECLARE_CLASS(QStyleOptionSpinBox)
+QT_FORWARD_DECLARE_CLASS(QTabWidget)
+QT_FORWARD_DECLARE_CLASS(QTableView)
+QT_FORWARD_DECLARE_CLASS(QTextBrowser)
+QT_FORWARD_DECLARE_CLASS(QTimeEdit)
+QT_FORWARD_DECLARE_CLASS(QTimer)
+QT_FORWARD_DECLARE_CLASS(QTreeView)
+QT_FORWARD_DECLARE_CLASS(QUndoStack)
+QT_FORWARD_DECLARE_CLASS(QWheelEvent)
+QT_FORWARD_DECLARE_CLASS(QXmlStreamReader)
+QT_FORWARD_DECLARE_CLASS(QXmlStreamWriter)
+
+// Implementation classes, defined in parameditor_p.h and held here only through pointers.
+class ParamAuditWriter;
+class ParamPage;
+class RecordTableModel;
+class Sparkline;
+class VariantTreeModel;
+template<typename T> class LockFreeQueue;
+
+/* -------------------------------------
+   Compact Spin Boxes
+   ------------------------------------- */
+
+/**
+ * @class CompactSpinBox
+ * @brief QSpinBox sized for a realistic number of digits instead of its range limits.
+ *
+ * QAbstractSpinBox sizes itself by formatting its minimum and maximum, which for
+ * ranges like INT_MIN..INT_MAX measures numbers no one types. This box measures
+ * a template of at most MaxDigits digits, derived from the range without
+ * formatting it, and shares the result among all boxes with the same font,
+ * style, prefix, suffix and width (see CompactDoubleSpinBox::cachedHint()).
+ */
+class CompactSpinBox : public QSpinBox {
+    Q_OBJECT
+public:
+    static const int MaxDigits = 10; ///< Most integer digits a box is sized for.
+
+    /**
+     * @brief Constructor for CompactSpinBox.
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit CompactSpinBox(QWidget* parent = nullptr) : QSpinBox(parent) {}
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+private:
+    /**
+     * @brief Compute the size hint, or the minimum size hint if least is true.
+     */
+    QSize hint(bool least) const;
+};
+
+/**
+ * @class CompactDoubleSpinBox
+ * @brief QDoubleSpinBox sized for a realistic number of digits instead of its range limits.
+ *
+ * Same as CompactSpinBox; a -DBL_MAX..DBL_MAX range no longer formats numbers of
+ * over 300 digits to compute a size hint.
+ */
+class CompactDoubleSpinBox : public QDoubleSpinBox {
+    Q_OBJECT
+public:
+    static const int MaxChars = 18; ///< Most characters of a number a box is sized for.
+
+    /**
+     * @brief Constructor for CompactDoubleSpinBox.
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit CompactDoubleSpinBox(QWidget* parent = nullptr) : QDoubleSpinBox(parent) {}
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+    /**
+     * @brief Size hint of a spin box showing a given template, cached per font, style and template.
+     * @param box Spin box to measure.
+     * @param option Style option of the box.
+     * @param text Widest text expected, prefix and suffix included.
+     * @param editHeight Height hint of the box's line edit.
+     * @return Size hint, from the cache after the first call for the same key.
+     */
+    static QSize cachedHint(const QAbstractSpinBox* box, const QStyleOptionSpinBox& option,
+        const QString& text, int editHeight);
+
+    /**
+     * @brief Number of integer digits needed for the larger magnitude of a range, at most CompactSpinBox::MaxDigits.
+     */
+    static int integerDigits(double min, double max);
+
+private:
+    /**
+     * @brief Compute the size hint, or the minimum size hint if least is true.
+     */
+    QSize hint(bool least) const;
+};
+
+/* -------------------------------------
+   Units
+   ------------------------------------- */
+
+/**
+ * @struct UnitConversion
+ * @brief Precomputed linear conversion between a display unit and the canonical unit.
+ *
+ * canonical = display * scale + offset. The inverse scale is stored as well, so
+ * converting in either direction costs one multiply and one add.
+ */
+struct UnitConversion {
+    QString unit; ///< Unit symbol, shown as the spin box suffix.
+    double  scale = 1.0; ///< Canonical units per display unit.
+    double  offset = 0.0; ///< Canonical value of a display value of zero.
+    double  invScale = 1.0; ///< 1 / scale.
+
+    double toCanonical(double display) const { return display * scale + offset; } ///< Display to canonical.
+    double toDisplay(double canonical) const { return (canonical - offset) * invScale; } ///< Canonical to display.
+};
+
+/**
+ * @class ParamUnits
+ * @brief Registry of the units of each physical dimension.
+ *
+ * The first unit defined for a dimension is its canonical unit: referenced
+ * variables and saved files always hold canonical values, and the other units
+ * are defined relative to it. Lookups happen when a unit is selected, never
+ * when a value is shown or saved. Use from the GUI thread only.
+ */
+class ParamUnits {
+    QHash<QString, QVector<UnitConversion>> dimensions; ///< Units of each dimension, canonical first.
+
+    ParamUnits();
+
+public:
+    /**
+     * @brief Access the process-wide registry.
+     */
+    static ParamUnits& instance();
+
+    /**
+     * @brief Define a unit, or redefine an existing one.
+     * @param dimension Physical dimension (e.g. "length").
+     * @param unit Unit symbol (e.g. "in").
+     * @param scale Canonical units per unit; the first unit of a dimension should use 1.
+     * @param offset Canonical value of zero in this unit (default: 0).
+     */
+    void define(const QString& dimension, const QString& unit, double scale, double offset = 0.0);
+
+    /**
+     * @brief Resolve a unit of a dimension.
+     * @param dimension Physical dimension.
+     * @param unit Unit symbol; empty or unknown symbols resolve to the canonical unit.
+     * @return The conversion, the identity with an empty symbol for unknown dimensions.
+     */
+    UnitConversion conversion(const QString& dimension, const QString& unit = QString()) const;
+
+    /**
+     * @brief Get the unit symbols of a dimension, canonical first.
+     */
+    QStringList units(const QString& dimension) const;
+};
+
+/**
+ * @class UnitSpinBox
+ * @brief Double spin box that shows a canonical value in a display unit.
+ *
+ * The range, step and value are set in canonical units. The last canonical value
+ * set is kept next to the value it was shown as, so switching units back and
+ * forth never accumulates rounding: the canonical value only changes when the
+ * user edits the field. Without a unit it behaves as a plain QDoubleSpinBox.
+ */
+class UnitSpinBox : public CompactDoubleSpinBox {
+    Q_OBJECT
+    UnitConversion  conv; ///< Conversion to the display unit.
+    double          canonicalMin = 0.0; ///< Minimum in canonical units.
+    double          canonicalMax = 99.99; ///< Maximum in canonical units.
+    double          canonicalStep = 1.0; ///< Step in canonical units.
+    double          canonical = 0.0; ///< Last canonical value set.
+    double          shown = 0.0; ///< Display value canonical was shown as.
+    int             baseDecimals = -1; ///< Decimals in the canonical unit, -1 until a unit is set.
+
+public:
+    /**
+     * @brief Constructor for UnitSpinBox.
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit UnitSpinBox(QWidget* parent = nullptr) : CompactDoubleSpinBox(parent) {}
+
+    /**
+     * @brief Set the range in canonical units.
+     */
+    void setCanonicalRange(double min, double max);
+
+    /**
+     * @brief Set the step in canonical units.
+     */
+    void setCanonicalStep(double step);
+
+    double canonicalMinimum() const { return canonicalMin; } ///< Minimum in canonical units.
+    double canonicalMaximum() const { return canonicalMax; } ///< Maximum in canonical units.
+
+    /**
+     * @brief Show a canonical value.
+     * @param v Value in canonical units; it is clamped to the range.
+     */
+    void setCanonicalValue(double v);
+
+    /**
+     * @brief Get the value in canonical units.
+     */
+    double canonicalValue() const;
+
+    /**
+     * @brief Switch the display unit, keeping the canonical value.
+     *
+     * Decimals follow the unit's magnitude; no signal is emitted.
+     * @param c Conversion to the new display unit.
+     */
+    void setConversion(const UnitConversion& c);
+
+    /**
+     * @brief Forget the unit, range, step and value, as in a new box (see ParamWidgetPool).
+     */
+    void restoreDefaults();
+};
+
+/* -------------------------------------
+   Editor Widget Pool
+   ------------------------------------- */
+
+/**
+ * @class ParamWidgetPool
+ * @brief Process-wide pool of the editor widgets most parameters are made of.
+ *
+ * Line edits, check boxes, CompactSpinBox and UnitSpinBox instances taken with
+ * take() come from a per-type free list when one is available, already
+ * constructed and polished. ParamBase returns the widgets it took through
+ * ParamBase::pooled() when it is destroyed: they are reset to the state of a
+ * new widget, unparented and kept up to capacity() per type; the rest are
+ * deleted. Other widget types are never pooled. Use from the GUI thread only.
+ *
+ * The pool never shrinks by itself: up to capacity() widgets per type stay
+ * allocated until the application quits. Qt 5 has no memory pressure signal,
+ * so the caller calls trim() when it knows they will not be needed soon, e.g.
+ * after closing its last editor or on a low-memory notice of the platform.
+ * checks/pool_reopen.cpp measures opening and closing a large editor with and
+ * without the pool.
+ */
+class ParamWidgetPool {
+public:
+    static const int DefaultCapacity = 512; ///< Widgets kept per type unless setCapacity() says otherwise.
+
+    /**
+     * @brief Get a widget of type W, reused if possible.
+     * @param parent Parent widget.
+     */
+    template<typename W>
+    static W* take(QWidget* parent) {
+        if (QWidget* w = takeFree(&W::staticMetaObject)) {
+            w->setParent(parent);
+            return static_cast<W*>(w);
+        }
+        return new W(parent);
+    }
+
+    /**
+     * @brief Give a widget back: it is reset and kept, or deleted if its type is full or not pooled.
+     */
+    static void release(QWidget* w);
+
+    /**
+     * @brief Set how many free widgets are kept per type, deleting the excess.
+     */
+    static void setCapacity(int perType);
+
+    static int capacity(); ///< Free widgets kept per type.
+    static int freeCount(); ///< Free widgets held, all types together.
+
+    /**
+     * @brief Delete free widgets; never called by the pool itself.
+     *
+     * Call it after closing the last editor or under memory pressure.
+     * @param keepPerType Free widgets kept per type (default: none).
+     */
+    static void trim(int keepPerType = 0);
+
+private:
+    static QWidget* takeFree(const QMetaObject* type);
+
+    /**
+     * @brief Bring a returned widget back to the state of a new one.
+     */
+    static void resetWidget(QWidget* w);
+};
 
  /**
   * @class ParamBase
@@ -50,10 +386,26 @@
 class ParamBase : public QWidget {
     Q_OBJECT
 public:
+    /**
+     * @brief When an edit typed into a text field becomes a committed change, reported by changed().
+     *
+     * Check boxes, combo box selections, sliders and the other non-text editors
+     * always commit at once, as do values set by code (reset, paste, load, undo).
+     */
+    enum CommitPolicy {
+        InheritCommit, ///< Use the policy of the editor (see ParamsEditor::setCommitPolicy()).
+        CommitPerKeystroke, ///< On every keystroke, once no other keystroke follows within the debounce delay.
+        CommitOnEnter, ///< When Enter is pressed; a pending edit is committed by Apply.
+        CommitOnFocusOut ///< When Enter is pressed or the field loses the focus.
+    };
+    Q_ENUM(CommitPolicy)
+
     QString     name; ///< Parameter name displayed in the GUI.
     QWidget     * widget = nullptr; ///< Widget for user input (e.g., QSpinBox, QLineEdit).
     QPushButton * defButton = nullptr; ///< Button to reset to default value.
     QPushButton * browseButton = nullptr; ///< Button for file/directory browsing (used by FilePathParam and DirParam).
+    QLabel      * label = nullptr; ///< Row label, created when the row is first shown.
+    qint64      latencyStamp = 0; ///< Start of the edit being measured by ParamLatency, 0 if none.
 
     /**
      * @brief Apply the current widget value to the referenced variable.
@@ -78,9 +430,201 @@ public:
     virtual void load(QXmlStreamReader& r) = 0;
 
     /**
-     * @brief Virtual destructor for proper cleanup.
+     * @brief Get the value currently shown by the widget.
+     *
+     * Used by the clipboard and the persistence backends. Subclasses that do not
+     * override it return an invalid QVariant and are skipped.
+     * @return The widget value.
+     */
+    virtual QVariant value() const { return QVariant(); }
+
+    /**
+     * @brief Show a value in the widget, without applying it.
+     * @param v Value in the format returned by value().
+     */
+    virtual void setValue(const QVariant& v) { Q_UNUSED(v); }
+
+    /**
+     * @brief Get the value held by the referenced variable, in the value() format.
+     * @return The applied value, or an invalid QVariant if not supported.
+     */
+    virtual QVariant storedValue() const { return QVariant(); }
+
+    /**
+     * @brief Check whether the value shown by the widget can be applied.
+     */
+    virtual bool isValid() const { return true; }
+
+    /**
+     * @brief Preferred row height inside a ParamPage.
+     * @return Height in pixels, or 0 to use the standard single-line row height.
+     */
+    virtual int rowHeightHint() const { return 0; }
+
+    /**
+     * @brief Give the value a physical dimension and choose its display unit.
+     *
+     * The referenced variable and saved files keep canonical units (see
+     * ParamUnits). Only the floating-point types (DoubleParam, FloatParam,
+     * SliderParam and RangeParam) show units; other types ignore them.
+     * @param dimension Physical dimension (e.g. "length").
+     * @param displayUnit Unit shown in the widget (default: the canonical unit).
+     */
+    void setUnit(const QString& dimension, const QString& displayUnit = QString());
+
+    /**
+     * @brief Get the physical dimension set by setUnit(), or an empty string.
+     */
+    QString unitDimension() const { return unitDim; }
+
+    /**
+     * @brief Show the value in another unit of its dimension, without emitting changed().
+     * @param unit Conversion to the display unit, resolved by ParamUnits.
+     */
+    virtual void setDisplayUnit(const UnitConversion& unit) { Q_UNUSED(unit); }
+
+    /**
+     * @brief Create the widget of a parameter that builds it lazily.
+     *
+     * Called by ParamPage before the row is first laid out, if widget is still
+     * null. Parameters creating their widget in the constructor keep this no-op.
+     */
+    virtual void createWidget() {}
+
+    /**
+     * @brief Virtual destructor; gives the widgets taken with pooled() back to the ParamWidgetPool.
+     */
+    virtual ~ParamBase();
+
+    /**
+     * @brief Connect the editing signals of the parameter widgets to changed().
+     *
+     * Called by ParamsEditor when the parameter is added. Spin boxes, date/time
+     * edits, line edits, combo boxes and checkable buttons below the parameter are
+     * tracked; parameters using other editors emit changed() themselves or
+     * override this method. Calls after the first do nothing.
+     */
+    virtual void trackEdits();
+
+    /**
+     * @brief Choose when text edits of this parameter are committed, overriding the editor.
+     * @param policy Commit policy; InheritCommit restores the editor's policy.
+     * @param debounceMs Delay after the last keystroke for CommitPerKeystroke, in milliseconds.
+     */
+    void setCommitPolicy(CommitPolicy policy, int debounceMs = 0);
+
+    /**
+     * @brief Set the policy used while none is set on the parameter itself.
+     *
+     * Called by ParamsEditor when the parameter is added and when the editor's policy changes.
+     * @param policy Commit policy of the editor.
+     * @param debounceMs Debounce delay of the editor, in milliseconds.
+     */
+    void setInheritedCommitPolicy(CommitPolicy policy, int debounceMs);
+
+    /**
+     * @brief Get the commit policy in effect, never InheritCommit.
+     */
+    CommitPolicy commitPolicy() const;
+
+    /**
+     * @brief Commit a pending text edit now, emitting changed() if there is one.
+     */
+    void commitEdit();
+
+signals:
+    /**
+     * @brief Emitted when the value shown by the widget changes.
+     *
+     * For text fields this follows the commit policy: it is emitted when an edit
+     * is committed, not on every keystroke.
+     */
+    void changed();
+
+    /**
+     * @brief Emitted by the editor after apply() has written the referenced variable.
+     */
+    void applied();
+
+    /**
+     * @brief Emitted when isValid() changes.
+     * @param valid The new validity.
+     */
+    void validityChanged(bool valid);
+
+protected:
+    /**
+     * @brief Report an edit of a text field; it becomes changed() as the commit policy says.
+     * @param field Edited field; changes made while it does not have the focus commit at once.
+     */
+    void textEdited(QWidget* field);
+
+    /**
+     * @brief Connect Enter and focus-out of a text field (spin box, line edit or editable combo box) to the commit policy.
+     */
+    void trackCommit(QWidget* field);
+
+    /**
+     * @brief Mark the edits as tracked; trackEdits() overrides call it first.
+     * @return False if the edits are already tracked, so nothing is connected twice.
+     */
+    bool beginTracking() {
+        if (editsTracked) return false;
+        editsTracked = true;
+        return true;
+    }
+
+    /**
+     * @brief Create an editor widget of type W from the ParamWidgetPool, as a child of the parameter.
+     *
+     * The widget returns to the pool when the parameter is destroyed, unless it
+     * was reparented or deleted before.
+     */
+    template<typename W>
+    W* pooled() {
+        W* w = ParamWidgetPool::take<W>(this);
+        pooledWidgets.append(w);
+        return w;
+    }
+
+    /**
+     * @brief Emit changed() during a continuous gesture, at most at the rate set with setGestureRate().
+     *
+     * The change is emitted now if the interval has elapsed, otherwise once it
+     * has; endGesture() emits the final one.
+     */
+    void throttledChanged();
+
+    /**
+     * @brief End a continuous gesture: drop the pending change and emit changed().
+     */
+    void endGesture();
+
+    /**
+     * @brief Set the maximum rate of throttledChanged().
+     * @param hz Changes per second; 0 or less emits every change.
      */
-    virtual ~ParamBase() {}
+    void setGestureRate(double hz) { gestureMs = hz > 0 ? qMax(1, qRound(1000.0 / hz)) : 0; }
+
+private:
+    /**
+     * @brief End of an edit session of a text field.
+     * @param enter True if Enter was pressed, false on focus-out.
+     */
+    void finishEdit(bool enter);
+
+    bool            editsTracked = false; ///< True once trackEdits() has run.
+    QString         unitDim; ///< Physical dimension set by setUnit().
+    CommitPolicy    ownPolicy = InheritCommit; ///< Policy set on the parameter itself.
+    int             ownDebounce = 0; ///< Debounce delay set on the parameter itself.
+    CommitPolicy    inheritedPolicy = CommitPerKeystroke; ///< Policy of the editor.
+    int             inheritedDebounce = 0; ///< Debounce delay of the editor.
+    bool            editPending = false; ///< True if a text edit waits to be committed.
+    QTimer          * debounce = nullptr; ///< Commits per-keystroke edits after the delay, created on first use.
+    QTimer          * throttle = nullptr; ///< Emits the trailing change of a gesture, created on first use.
+    QElapsedTimer   lastGestureEmit; ///< Time of the last change emitted during a gesture.
+    int             gestureMs = 33; ///< Minimum interval between changes during a gesture.
+    QVector<QPointer<QWidget>> pooledWidgets; ///< Widgets taken with pooled().
 
 protected:
     /**
@@ -98,7 +642,7 @@ class DoubleParam : public ParamBase {
     Q_OBJECT
         double* ptr; ///< Pointer to the double value.
     double defVal; ///< Default value.
-    QDoubleSpinBox* spin; ///< Spin box for user input.
+    UnitSpinBox* spin; ///< Spin box for user input.
 public:
     /**
      * @brief Constructor for DoubleParam.
@@ -110,31 +654,17 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    DoubleParam(QString name, double* p, double min, double max, double step, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = *p;
-        spin = new QDoubleSpinBox(this);
-        spin->setRange(min, max);
-        spin->setSingleStep(step);
-        spin->setValue(*p);
-        spin->setToolTip(tip);
-        spin->setAlignment(Qt::AlignRight);
-        widget = spin;
-    }
-    void apply() override { *ptr = spin->value(); }
-    void reset() override { spin->setValue(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", QString::number(spin->value()));
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            spin->setValue(r.attributes().value("value").toDouble());
-        r.readNext();
-    }
+    DoubleParam(QString name, double* p, double min, double max, double step, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    double minimum() const; ///< Lowest value accepted by the widget.
+    double maximum() const; ///< Highest value accepted by the widget.
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void setDisplayUnit(const UnitConversion& unit) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -157,31 +687,76 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    IntParam(QString name, int* p, int min, int max, int step, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = *p;
-        spin = new QSpinBox(this);
-        spin->setRange(min, max);
-        spin->setSingleStep(step);
-        spin->setValue(*p);
-        spin->setToolTip(tip);
-        spin->setAlignment(Qt::AlignRight);
-        widget = spin;
-    }
-    void apply() override { *ptr = spin->value(); }
-    void reset() override { spin->setValue(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", QString::number(spin->value()));
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            spin->setValue(r.attributes().value("value").toInt());
-        r.readNext();
-    }
+    IntParam(QString name, int* p, int min, int max, int step, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    int minimum() const; ///< Lowest value accepted by the widget.
+    int maximum() const; ///< Highest value accepted by the widget.
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+};
+
+/**
+ * @class PatternValidator
+ * @brief Validates a QLineEdit against a regular expression from a shared cache.
+ *
+ * Patterns are compiled, anchored and optimized once; every validator using
+ * the same pattern shares the compiled expression. The cache keeps the
+ * CacheCapacity most recently compiled patterns, so generated patterns cannot
+ * grow it without bound. Checking reuses the line edit's text without copying
+ * it and only touches the palette when the validity actually changes. It is not
+ * allocation-free: QRegularExpression::match() allocates its result on every
+ * check, and Qt 5 offers no matching call without one.
+ */
+class PatternValidator {
+    QRegularExpression regex; ///< Shared compiled pattern.
+    bool active = false; ///< True if a pattern is set.
+    bool valid = true; ///< Result of the last check.
+    bool bound = false; ///< True once bind() has connected the line edit.
+
+public:
+    static const int CacheCapacity = 256; ///< Compiled patterns kept by compiled().
+
+    /**
+     * @brief Get the compiled, anchored and optimized expression for a pattern.
+     * @param pattern Regular expression matched against the whole text.
+     */
+    static QRegularExpression compiled(const QString& pattern);
+
+    /**
+     * @brief Set the pattern, or clear it with an empty string.
+     */
+    void setPattern(const QString& pattern);
+
+    /**
+     * @brief Set the pattern of a parameter's line edit and check it on every change.
+     *
+     * The line edit is connected on the first call only.
+     * @param owner Parameter owning the validator; emits validityChanged() when the validity changes.
+     * @param edit Checked line edit.
+     * @param pattern Pattern matched against the whole text; empty to disable.
+     */
+    void bind(ParamBase* owner, QLineEdit* edit, const QString& pattern);
+
+    /**
+     * @brief Get the pattern set by setPattern() (anchored).
+     */
+    QString pattern() const;
+
+    /**
+     * @brief Get the result of the last check.
+     */
+    bool isValid() const { return valid; }
+
+    /**
+     * @brief Check the text of a line edit and mark it if invalid.
+     * @param edit Line edit to check.
+     * @return True if the validity changed.
+     */
+    bool check(QLineEdit* edit);
 };
 
 /**
@@ -194,6 +769,7 @@ protected:  // Cambiato da private a protected
     QString     * ptr; ///< Pointer to the string value.
     QString     defVal; ///< Default value.
     QLineEdit   * edit; ///< Line edit for user input.
+    PatternValidator validator; ///< Optional pattern the text must match.
 public:
     /**
      * @brief Constructor for StringParam.
@@ -204,28 +780,24 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    StringParam(QString name, QString* p, QString def, Qt::InputMethodHints hints, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        edit = new QLineEdit(*p, this);
-        edit->setInputMethodHints(hints);
-        edit->setToolTip(tip);
-        widget = edit;
-    }
-    void apply() override { *ptr = edit->text(); }
-    void reset() override { edit->setText(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", edit->text());
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            edit->setText(r.attributes().value("value").toString());
-        r.readNext();
-    }
+    StringParam(QString name, QString* p, QString def, Qt::InputMethodHints hints, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Require the text to match a regular expression.
+     *
+     * The text is checked on every keystroke; while it does not match, the field
+     * is highlighted and the editor disables Apply.
+     * @param pattern Pattern matched against the whole text; empty to disable.
+     */
+    void setPattern(const QString& pattern);
+    bool isValid() const override;
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 };
 
 
@@ -249,30 +821,15 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    ComboParam(QString name, QStringList* opts, int* p, int defIndex, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        options = opts;
-        ptr = p;
-        defVal = defIndex;
-        combo = new QComboBox(this);
-        combo->addItems(*opts);
-        combo->setCurrentIndex(*p);
-        combo->setToolTip(tip);
-        widget = combo;
-    }
-    void apply() override { *ptr = combo->currentIndex(); }
-    void reset() override { combo->setCurrentIndex(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("index", QString::number(combo->currentIndex()));
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("index"))
-            combo->setCurrentIndex(r.attributes().value("index").toInt());
-        r.readNext();
-    }
+    ComboParam(QString name, QStringList* opts, int* p, int defIndex, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QStringList items() const; ///< Options offered by the combo box.
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -284,6 +841,7 @@ class ColorParam : public ParamBase {
     QColor      * ptr; ///< Pointer to the color value.
     QColor      defVal; ///< Default color.
     QPushButton * btn; ///< Button to open the color dialog.
+    QColor      current; ///< Color currently shown on the button.
 public:
     /**
      * @brief Constructor for ColorParam.
@@ -293,45 +851,20 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    ColorParam(QString name, QColor* p, QColor def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        btn = new QPushButton(this);
-        updateButton(*ptr);
-        btn->setToolTip(tip);
-        QObject::connect(btn, &QPushButton::clicked, [this, name]() {
-            QColor c = QColorDialog::getColor(*ptr, nullptr, name);
-            if (c.isValid()) {
-                updateButton(c);
-                *ptr = c;
-            }
-            });
-        widget = btn;
-    }
-    void apply() override { *ptr = btn->palette().button().color(); }
-    void reset() override { updateButton(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("color", btn->palette().button().color().name());
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("color"))
-            updateButton(QColor(r.attributes().value("color").toString()));
-        r.readNext();
-    }
+    ColorParam(QString name, QColor* p, QColor def, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override { return current; }
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 private:
     /**
      * @brief Update the button's background color.
      * @param c The color to set.
      */
-    void updateButton(const QColor& c) {
-        btn->setStyleSheet(QString("QPushButton { background-color: %1; border: 1px solid black; }").arg(c.name()));
-        btn->setAutoFillBackground(true);
-        btn->update();
-    }
+    void updateButton(const QColor& c);
 };
 
 /**
@@ -352,37 +885,19 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    FilePathParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        edit = new QLineEdit(*p, this);
-        edit->setToolTip(tip);
-        widget = edit;
-        browseButton = nullptr;
-    }
-    void apply() override { *ptr = edit->text(); }
-    void reset() override { edit->setText(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("path", edit->text());
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("path"))
-            edit->setText(r.attributes().value("path").toString());
-        r.readNext();
-    }
+    FilePathParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 public slots:
     /**
      * @brief Open a file dialog to select a file.
      */
-    void onBrowseClicked() {
-        QString file = QFileDialog::getOpenFileName(widget, "Select File", edit->text());
-        if (!file.isEmpty())
-            edit->setText(file);
-    }
+    void onBrowseClicked();
 };
 
 /**
@@ -403,37 +918,19 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    DirParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        edit = new QLineEdit(*p, this);
-        edit->setToolTip(tip);
-        widget = edit;
-        browseButton = nullptr;
-    }
-    void apply() override { *ptr = edit->text(); }
-    void reset() override { edit->setText(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("path", edit->text());
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("path"))
-            edit->setText(r.attributes().value("path").toString());
-        r.readNext();
-    }
+    DirParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 public slots:
     /**
      * @brief Open a directory dialog to select a directory.
      */
-    void onBrowseClicked() {
-        QString dir = QFileDialog::getExistingDirectory(widget, "Select Directory", edit->text());
-        if (!dir.isEmpty())
-            edit->setText(dir);
-    }
+    void onBrowseClicked();
 };
 
 /**
@@ -454,28 +951,14 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    BoolParam(QString name, bool* p, bool def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        checkBox = new QCheckBox(this);
-        checkBox->setChecked(*p);
-        checkBox->setToolTip(tip);
-        widget = checkBox;
-    }
-    void apply() override { *ptr = checkBox->isChecked(); }
-    void reset() override { checkBox->setChecked(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", checkBox->isChecked() ? "true" : "false");
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            checkBox->setChecked(r.attributes().value("value").toString() == "true");
-        r.readNext();
-    }
+    BoolParam(QString name, bool* p, bool def, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -498,55 +981,27 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    FontParam(QString name, QFont* p, QFont def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        currentFont = *p;
-        btn = new QPushButton(this);
-        updateButton(currentFont);
-        btn->setToolTip(tip);
-        QObject::connect(btn, &QPushButton::clicked, [this, name]() {
-            bool ok;
-            QFont font = QFontDialog::getFont(&ok, currentFont, nullptr, name);
-            if (ok) {
-                currentFont = font;
-                updateButton(font);
-            }
-            });
-        widget = btn;
-    }
-    void apply() override { *ptr = currentFont; }
-    void reset() override {
-        currentFont = defVal;
-        updateButton(defVal);
-    }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", currentFont.toString());
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value")) {
-            currentFont.fromString(r.attributes().value("value").toString());
-            updateButton(currentFont);
-        }
-        r.readNext();
-    }
+    FontParam(QString name, QFont* p, QFont def, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override { return currentFont; }
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
 private:
     /**
      * @brief Update the button's text to show font details.
      * @param f The font to display.
      */
-    void updateButton(const QFont& f) {
-        btn->setText(f.family() + " " + QString::number(f.pointSize()));
-    }
+    void updateButton(const QFont& f);
 };
 
 /**
  * @class PasswordParam
  * @brief Parameter class for handling password strings with hidden input.
+ *
+ * The password is left out of copies (see ParamsEditor::createMimeData()).
  */
 class PasswordParam : public StringParam {
     Q_OBJECT
@@ -559,10 +1014,7 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    PasswordParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr)
-        : StringParam(name, p, def, Qt::ImhHiddenText, tip, parent) {
-        edit->setEchoMode(QLineEdit::Password);
-    }
+    PasswordParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr);
 };
 
 /**
@@ -587,31 +1039,150 @@ public:
      */
     DateTimeParam(QString name, QDateTime* p, QDateTime def,
         QString tip = "", QString format = "dd/MM/yyyy hh:mm",
-        QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        dateTimeEdit = new QDateTimeEdit(*p, this);
-        dateTimeEdit->setDisplayFormat(format);
-        dateTimeEdit->setToolTip(tip);
-        dateTimeEdit->setCalendarPopup(true);
-        widget = dateTimeEdit;
-    }
-    void apply() override { *ptr = dateTimeEdit->dateTime(); }
-    void reset() override { dateTimeEdit->setDateTime(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", dateTimeEdit->dateTime().toString(Qt::ISODate));
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value")) {
-            QDateTime dt = QDateTime::fromString(r.attributes().value("value").toString(), Qt::ISODate);
-            if (dt.isValid()) dateTimeEdit->setDateTime(dt);
-        }
-        r.readNext();
-    }
+        QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+};
+
+/**
+ * @class CompoundEditor
+ * @brief Single widget editing a few numbers, such as the fields of a QRect.
+ *
+ * The fields are painted as labelled line-edit frames, so an idle editor has no
+ * child widgets. Clicking a field, pressing Enter or F2, or typing a number opens
+ * one shared UnitSpinBox over it, created on first use; Enter, Tab and focus-out
+ * commit, Escape cancels. Without the spin box, Left and Right select a field,
+ * and Up, Down, PageUp and PageDown step it. Values are canonical and shown in
+ * the display unit set with setConversion(), as with UnitSpinBox.
+ */
+class CompoundEditor : public QWidget {
+    Q_OBJECT
+
+    /// One edited number.
+    struct Field {
+        QString label; ///< Text painted before the field, may be empty.
+        QString tip; ///< Tooltip of the field.
+        double  value = 0.0; ///< Canonical value.
+        double  min = 0.0; ///< Canonical minimum.
+        double  max = 0.0; ///< Canonical maximum.
+        double  step = 1.0; ///< Canonical step.
+        QRect   labelRect; ///< Label area, in widget coordinates.
+        QRect   boxRect; ///< Frame of the value, in widget coordinates.
+    };
+
+    QVector<Field>  fields; ///< Edited numbers, left to right.
+    int             decimals; ///< Decimals in the canonical unit.
+    UnitConversion  conv; ///< Conversion to the display unit.
+    int             current = 0; ///< Field selected with the keyboard.
+    int             editing = -1; ///< Field under the spin box, or -1.
+    UnitSpinBox     * spin = nullptr; ///< Editor of the field being edited, created on first use.
+    bool            layoutStale = true; ///< True if the field rectangles must be recomputed.
+    mutable QSize   cachedHint; ///< Size hint, empty until computed.
+
+public:
+    /**
+     * @brief Constructor for CompoundEditor.
+     * @param decimals Decimals shown in the canonical unit (0 for integer fields).
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit CompoundEditor(int decimals, QWidget* parent = nullptr);
+
+    /**
+     * @brief Append a field.
+     * @param label Text painted before the field.
+     * @param min Canonical minimum.
+     * @param max Canonical maximum.
+     * @param step Canonical step.
+     * @param tip Tooltip of the field.
+     * @return Index of the field.
+     */
+    int addField(const QString& label, double min, double max, double step, const QString& tip);
+
+    /**
+     * @brief Get the canonical value of a field.
+     */
+    double value(int field) const;
+
+    /**
+     * @brief Set the canonical value of a field, clamped to its range.
+     *
+     * Emits valueChanged() if the value changes.
+     */
+    void setValue(int field, double v);
+
+    double minimum(int field) const; ///< Canonical minimum of a field.
+    double maximum(int field) const; ///< Canonical maximum of a field.
+
+    /**
+     * @brief Show the fields in another display unit, without emitting valueChanged().
+     * @param c Conversion to the display unit.
+     */
+    void setConversion(const UnitConversion& c);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted when the value of a field changes, by editing or by setValue().
+     * @param field Index of the field.
+     */
+    void valueChanged(int field);
+
+protected:
+    bool event(QEvent* e) override;
+    bool eventFilter(QObject* watched, QEvent* e) override;
+    bool focusNextPrevChild(bool next) override;
+    void paintEvent(QPaintEvent* e) override;
+    void resizeEvent(QResizeEvent* e) override;
+    void changeEvent(QEvent* e) override;
+    void focusInEvent(QFocusEvent* e) override;
+    void focusOutEvent(QFocusEvent* e) override;
+    void mousePressEvent(QMouseEvent* e) override;
+    void keyPressEvent(QKeyEvent* e) override;
+    void wheelEvent(QWheelEvent* e) override;
+
+private:
+    /**
+     * @brief Compute the label and frame rectangles of the fields.
+     */
+    void layoutFields();
+
+    /**
+     * @brief Get the field whose label or frame contains a point, or -1.
+     */
+    int fieldAt(const QPoint& pos);
+
+    /**
+     * @brief Get the text shown for a field, in the display unit.
+     */
+    QString text(int field) const;
+
+    /**
+     * @brief Width of the frame of a field, from its range without formatting it.
+     */
+    int boxWidth(int field) const;
+
+    /**
+     * @brief Step a field by a number of steps.
+     */
+    void stepField(int field, int steps);
+
+    /**
+     * @brief Show the spin box over a field and give it the focus.
+     */
+    void openEditor(int field);
+
+    /**
+     * @brief Hide the spin box.
+     * @param commit True to keep the edited value, false to discard it.
+     */
+    void closeEditor(bool commit);
 };
 
 /**
@@ -622,8 +1193,7 @@ class RangeParam : public ParamBase {
     Q_OBJECT
     QPair<double, double>   * ptr; ///< Pointer to the range values.
     QPair<double, double>   defVal; ///< Default range.
-    QDoubleSpinBox          * minSpin; ///< Spin box for min value.
-    QDoubleSpinBox          * maxSpin; ///< Spin box for max value.
+    CompoundEditor          * editor; ///< Editor of the min and max values.
 
 public:
     /**
@@ -639,62 +1209,31 @@ public:
      */
     RangeParam(QString name, QPair<double, double>* p,
         double globalMin, double globalMax, double step,
-        QPair<double, double> def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-
-        QWidget* container = new QWidget(this);
-        QHBoxLayout* layout = new QHBoxLayout(container);
-        layout->setContentsMargins(0, 0, 0, 0);
-
-        minSpin = new QDoubleSpinBox;
-        minSpin->setRange(globalMin, globalMax);
-        minSpin->setSingleStep(step);
-        minSpin->setValue(p->first);
-
-        maxSpin = new QDoubleSpinBox;
-        maxSpin->setRange(globalMin, globalMax);
-        maxSpin->setSingleStep(step);
-        maxSpin->setValue(p->second);
-
-        layout->addWidget(minSpin);
-        layout->addWidget(new QLabel("to"));
-        layout->addWidget(maxSpin);
-
-        widget = container;
-    }
+        QPair<double, double> def, QString tip, QWidget* parent = nullptr);
 
-    void apply() override {
-        ptr->first = minSpin->value();
-        ptr->second = maxSpin->value();
-    }
+    void apply() override;
 
-    void reset() override {
-        minSpin->setValue(defVal.first);
-        maxSpin->setValue(defVal.second);
-    }
+    void reset() override;
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("min", QString::number(minSpin->value()));
-        w.writeAttribute("max", QString::number(maxSpin->value()));
-        w.writeEndElement();
-    }
+    double minimum() const; ///< Lowest value accepted by the widget.
+    double maximum() const; ///< Highest value accepted by the widget.
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("min") && r.attributes().hasAttribute("max")) {
-            minSpin->setValue(r.attributes().value("min").toDouble());
-            maxSpin->setValue(r.attributes().value("max").toDouble());
-        }
-        r.readNext();
-    }
+    void setDisplayUnit(const UnitConversion& unit) override;
+
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
  * @class StringListParam
  * @brief Parameter class for handling string list values.
+ *
+ * The list is the comma-separated text of the editable combo box; its items
+ * only offer choices.
  */
 class StringListParam : public ParamBase {
     Q_OBJECT
@@ -711,41 +1250,19 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    StringListParam(QString name, QStringList* p, QStringList def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        combo = new QComboBox(this);
-        combo->setEditable(true); // Permette di aggiungere nuovi elementi
-        combo->addItems(*p);
-        combo->setToolTip(tip);
-        widget = combo;
-    }
+    StringListParam(QString name, QStringList* p, QStringList def, QString tip, QWidget* parent = nullptr);
 
-    void apply() override {
-        *ptr = combo->currentText().split(",", Qt::SkipEmptyParts);
-    }
+    void apply() override;
 
-    void reset() override {
-        combo->clear();
-        combo->addItems(defVal);
-    }
+    void reset() override;
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", combo->currentText());
-        w.writeEndElement();
-    }
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value")) {
-            combo->clear();
-            QStringList items = r.attributes().value("value").toString().split(",", Qt::SkipEmptyParts);
-            combo->addItems(items);
-        }
-        r.readNext();
-    }
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -767,34 +1284,18 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    DateParam(QString name, QDate* p, QDate def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        dateEdit = new QDateEdit(*p, this);
-        dateEdit->setDisplayFormat("dd/MM/yyyy");
-        dateEdit->setToolTip(tip);
-        dateEdit->setCalendarPopup(true);
-        widget = dateEdit;
-    }
+    DateParam(QString name, QDate* p, QDate def, QString tip, QWidget* parent = nullptr);
 
-    void apply() override { *ptr = dateEdit->date(); }
-    void reset() override { dateEdit->setDate(defVal); }
+    void apply() override;
+    void reset() override;
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", dateEdit->date().toString(Qt::ISODate));
-        w.writeEndElement();
-    }
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value")) {
-            QDate date = QDate::fromString(r.attributes().value("value").toString(), Qt::ISODate);
-            if (date.isValid()) dateEdit->setDate(date);
-        }
-        r.readNext();
-    }
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -816,33 +1317,18 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    TimeParam(QString name, QTime* p, QTime def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        timeEdit = new QTimeEdit(*p, this);
-        timeEdit->setDisplayFormat("hh:mm:ss");
-        timeEdit->setToolTip(tip);
-        widget = timeEdit;
-    }
+    TimeParam(QString name, QTime* p, QTime def, QString tip, QWidget* parent = nullptr);
 
-    void apply() override { *ptr = timeEdit->time(); }
-    void reset() override { timeEdit->setTime(defVal); }
+    void apply() override;
+    void reset() override;
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", timeEdit->time().toString(Qt::ISODate));
-        w.writeEndElement();
-    }
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value")) {
-            QTime time = QTime::fromString(r.attributes().value("value").toString(), Qt::ISODate);
-            if (time.isValid()) timeEdit->setTime(time);
-        }
-        r.readNext();
-    }
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -853,8 +1339,7 @@ class PointParam : public ParamBase {
     Q_OBJECT
     QPoint      * ptr; ///< Pointer to the point value.
     QPoint      defVal; ///< Default point value.
-    QSpinBox    * xSpin; ///< Spin box for x coordinate.
-    QSpinBox    * ySpin; ///< Spin box for y coordinate.
+    CompoundEditor * editor; ///< Editor of the x and y coordinates.
 
 public:
     /**
@@ -865,58 +1350,19 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    PointParam(QString name, QPoint* p, QPoint def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-
-        QWidget* container = new QWidget(this);
-        QHBoxLayout* layout = new QHBoxLayout(container);
-        layout->setContentsMargins(0, 0, 0, 0);
-
-        xSpin = new QSpinBox;
-        xSpin->setRange(INT_MIN, INT_MAX);
-        xSpin->setValue(p->x());
-        xSpin->setToolTip(tip + " (X coordinate)");
+    PointParam(QString name, QPoint* p, QPoint def, QString tip, QWidget* parent = nullptr);
 
-        ySpin = new QSpinBox;
-        ySpin->setRange(INT_MIN, INT_MAX);
-        ySpin->setValue(p->y());
-        ySpin->setToolTip(tip + " (Y coordinate)");
+    void apply() override;
 
-        layout->addWidget(new QLabel("X:"));
-        layout->addWidget(xSpin);
-        layout->addWidget(new QLabel("Y:"));
-        layout->addWidget(ySpin);
-
-        widget = container;
-    }
-
-    void apply() override {
-        ptr->setX(xSpin->value());
-        ptr->setY(ySpin->value());
-    }
+    void reset() override;
 
-    void reset() override {
-        xSpin->setValue(defVal.x());
-        ySpin->setValue(defVal.y());
-    }
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("x", QString::number(xSpin->value()));
-        w.writeAttribute("y", QString::number(ySpin->value()));
-        w.writeEndElement();
-    }
+    void save(QXmlStreamWriter& w) const override;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("x") && r.attributes().hasAttribute("y")) {
-            xSpin->setValue(r.attributes().value("x").toInt());
-            ySpin->setValue(r.attributes().value("y").toInt());
-        }
-        r.readNext();
-    }
+    void load(QXmlStreamReader& r) override;
 };
 
 /**
@@ -927,8 +1373,7 @@ class SizeParam : public ParamBase {
     Q_OBJECT
     QSize       * ptr; ///< Pointer to the size value.
     QSize       defVal; ///< Default size value.
-    QSpinBox    * widthSpin; ///< Spin box for width.
-    QSpinBox    * heightSpin; ///< Spin box for height.
+    CompoundEditor * editor; ///< Editor of the width and height.
 
 public:
     /**
@@ -939,458 +1384,2116 @@ public:
      * @param tip Tooltip text.
      * @param parent Parent widget (default: nullptr).
      */
-    SizeParam(QString name, QSize* p, QSize def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
+    SizeParam(QString name, QSize* p, QSize def, QString tip, QWidget* parent = nullptr);
 
-        QWidget* container = new QWidget(this);
-        QHBoxLayout* layout = new QHBoxLayout(container);
-        layout->setContentsMargins(0, 0, 0, 0);
+    void apply() override;
 
-        widthSpin = new QSpinBox;
-        widthSpin->setRange(0, INT_MAX);
-        widthSpin->setValue(p->width());
-        widthSpin->setToolTip(tip + " (Width)");
+    void reset() override;
 
-        heightSpin = new QSpinBox;
-        heightSpin->setRange(0, INT_MAX);
-        heightSpin->setValue(p->height());
-        heightSpin->setToolTip(tip + " (Height)");
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
 
-        layout->addWidget(new QLabel("Width:"));
-        layout->addWidget(widthSpin);
-        layout->addWidget(new QLabel("Height:"));
-        layout->addWidget(heightSpin);
+    void save(QXmlStreamWriter& w) const override;
 
-        widget = container;
-    }
+    void load(QXmlStreamReader& r) override;
+};
 
-    void apply() override {
-        ptr->setWidth(widthSpin->value());
-        ptr->setHeight(heightSpin->value());
-    }
+/**
+ * @class RectParam
+ * @brief Parameter class for handling rectangle values.
+ */
+class RectParam : public ParamBase {
+    Q_OBJECT
+    QRect       * ptr; ///< Pointer to the rectangle value.
+    QRect       defVal; ///< Default rectangle value.
+    CompoundEditor * editor; ///< Editor of x, y, width and height.
 
-    void reset() override {
-        widthSpin->setValue(defVal.width());
-        heightSpin->setValue(defVal.height());
-    }
+public:
+    /**
+     * @brief Constructor for RectParam.
+     * @param name Parameter name.
+     * @param p Pointer to the rectangle value.
+     * @param def Default rectangle.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    RectParam(QString name, QRect* p, QRect def, QString tip, QWidget* parent = nullptr);
+
+    void apply() override;
+
+    void reset() override;
+
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
+};
+
+/**
+ * @class VariantParam
+ * @brief Parameter class for handling QVariant values (fallback to string).
+ */
+class VariantParam : public ParamBase {
+    Q_OBJECT
+    QVariant    * ptr; ///< Pointer to the variant value.
+    QVariant    defVal; ///< Default variant value.
+    QLineEdit   * edit; ///< Line edit for user input.
+    PatternValidator validator; ///< Optional pattern the text must match.
+
+public:
+    /**
+     * @brief Constructor for VariantParam.
+     * @param name Parameter name.
+     * @param p Pointer to the variant value.
+     * @param def Default variant.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    VariantParam(QString name, QVariant* p, QVariant def, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Require the text to match a regular expression.
+     *
+     * The text is checked on every keystroke; while it does not match, the field
+     * is highlighted and the editor disables Apply.
+     * @param pattern Pattern matched against the whole text; empty to disable.
+     */
+    void setPattern(const QString& pattern);
+
+    bool isValid() const override;
+
+    void apply() override;
+    void reset() override;
+
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+
+    void save(QXmlStreamWriter& w) const override;
+
+    void load(QXmlStreamReader& r) override;
+};
+
+/**
+ * @class FloatParam
+ * @brief Parameter class for handling single-precision floating-point values.
+ */
+class FloatParam : public ParamBase {
+    Q_OBJECT
+        float* ptr; ///< Pointer to the float value.
+    float defVal; ///< Default value.
+    UnitSpinBox* spin; ///< Spin box for user input.
+public:
+    /**
+     * @brief Constructor for FloatParam.
+     * @param name Parameter name.
+     * @param p Pointer to the float value.
+     * @param min Minimum allowed value.
+     * @param max Maximum allowed value.
+     * @param step Step size for the spin box.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    FloatParam(QString name, float* p, float min, float max, float step, QString tip, QWidget* parent = nullptr);
+    void apply() override;
+    void reset() override;
+    double minimum() const; ///< Lowest value accepted by the widget.
+    double maximum() const; ///< Highest value accepted by the widget.
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void setDisplayUnit(const UnitConversion& unit) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+};
+
+/**
+ * @class SliderParam
+ * @brief Parameter class for numeric values edited with a slider and a spin box.
+ *
+ * While the slider is dragged the spin box follows every move, but changed() is
+ * emitted at most at the configured rate; releasing the slider emits the final
+ * value at once. With live apply enabled on the editor, bound variables and
+ * properties therefore see a bounded update rate during a drag.
+ */
+class SliderParam : public ParamBase {
+    Q_OBJECT
+    double          * dptr = nullptr; ///< Pointer to the double value (double mode).
+    int             * iptr = nullptr; ///< Pointer to the integer value (integer mode).
+    double          defVal; ///< Default value.
+    double          minVal; ///< Value at the left end of the slider.
+    double          maxVal; ///< Value at the right end of the slider.
+    QSlider         * slider; ///< Slider for coarse, live adjustment.
+    UnitSpinBox     * spin; ///< Spin box showing the exact value.
+
+public:
+    /**
+     * @brief Constructor for a double-valued SliderParam.
+     * @param name Parameter name.
+     * @param p Pointer to the double value.
+     * @param min Minimum allowed value.
+     * @param max Maximum allowed value.
+     * @param step Step size of the spin box and resolution of the slider.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    SliderParam(QString name, double* p, double min, double max, double step, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Constructor for an integer-valued SliderParam.
+     * @param name Parameter name.
+     * @param p Pointer to the integer value.
+     * @param min Minimum allowed value.
+     * @param max Maximum allowed value.
+     * @param step Step size.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    SliderParam(QString name, int* p, int min, int max, int step, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Set the maximum rate of changes emitted while dragging.
+     * @param hz Changes per second (default: 30).
+     */
+    void setMaxRate(double hz);
+
+    double minimum() const { return minVal; } ///< Lowest value accepted by the widget.
+    double maximum() const { return maxVal; } ///< Highest value accepted by the widget.
+
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void setDisplayUnit(const UnitConversion& unit) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    /**
+     * @brief Emit changed() from the spin box, and from the slider at a bounded rate.
+     */
+    void trackEdits() override;
+
+private:
+    void init(const QString& name, double value, double min, double max, double step, int decimals, const QString& tip);
+
+    int toSlider(double v) const;
+
+    double fromSlider(int pos) const;
+};
+
+/* -------------------------------------
+   Image Parameter and Thumbnail Cache
+   ------------------------------------- */
+
+/**
+ * @class ImageParam
+ * @brief Parameter class for handling image file paths with a thumbnail preview.
+ *
+ * The thumbnail is requested from ThumbnailCache the first time it is shown and
+ * whenever the path changes, so building a tab with many images costs no I/O.
+ */
+class ImageParam : public ParamBase {
+    Q_OBJECT
+    QString     * ptr; ///< Pointer to the image path.
+    QString     defVal; ///< Default image path.
+    QLineEdit   * edit; ///< Line edit for image path input.
+    QLabel      * thumb; ///< Label showing the thumbnail.
+    bool        thumbStale = true; ///< True if the thumbnail must be requested again.
+
+public:
+    /**
+     * @brief Constructor for ImageParam.
+     * @param name Parameter name.
+     * @param p Pointer to the image path.
+     * @param def Default image path.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    ImageParam(QString name, QString* p, QString def, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Size of the thumbnail shown next to the path.
+     */
+    static QSize thumbnailSize();
+
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    bool eventFilter(QObject* o, QEvent* e) override;
+
+public slots:
+    /**
+     * @brief Open a file dialog to select an image.
+     */
+    void onBrowseClicked();
+
+private slots:
+    /**
+     * @brief Request the thumbnail for the current path, deferred until visible.
+     */
+    void updateThumbnail();
+
+private:
+    void setThumbnail(const QImage& image);
+};
+
+/* -------------------------------------
+   Curve and Lookup-table Parameters
+   ------------------------------------- */
+
+/**
+ * @class PackedFloats
+ * @brief Compact text encoding of float arrays for the XML files.
+ *
+ * Values are stored as little-endian 32-bit floats, zlib-compressed and base64
+ * encoded, so a 1024x1024 table stays a single attribute of a few MiB at most.
+ */
+class PackedFloats {
+public:
+    /**
+     * @brief Encode an array of floats.
+     * @param data First value.
+     * @param count Number of values.
+     * @return The base64 text.
+     */
+    static QString encode(const float* data, int count);
+
+    /**
+     * @brief Decode text produced by encode().
+     *
+     * The size stored in the compressed header is checked before anything is
+     * inflated, so a small attribute cannot expand into a huge allocation.
+     * @param text The base64 text.
+     * @param maxCount Most values accepted.
+     * @return The values, or an empty vector if the text is malformed or too long.
+     */
+    static QVector<float> decode(const QStringRef& text, int maxCount);
+};
+
+/**
+ * @class CurveEditor
+ * @brief Interactive editor of a 1D transfer curve through spline control points.
+ *
+ * Control points live in the unit square, sorted by x, and are joined by cubic
+ * Hermite segments with Catmull-Rom tangents. Each segment is cached as its own
+ * QPainterPath; since a segment depends only on its two end points and their
+ * neighbours, dragging a point rebuilds and repaints at most four segments.
+ * Left click adds or drags a point, right click removes one.
+ */
+class CurveEditor : public QWidget {
+    Q_OBJECT
+    QVector<QPointF>        pts; ///< Control points in the unit square, sorted by x.
+    QVector<QPainterPath>   segments; ///< Cached path of each segment, in widget coordinates.
+    QVector<bool>           segmentStale; ///< True if the segment path must be rebuilt.
+    int                     dragIndex = -1; ///< Point being dragged, or -1.
+
+public:
+    /**
+     * @brief Constructor for CurveEditor.
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit CurveEditor(QWidget* parent = nullptr);
+
+    /**
+     * @brief Get the control points.
+     */
+    const QVector<QPointF>& points() const { return pts; }
+
+    /**
+     * @brief Replace the control points.
+     * @param p Points in the unit square; they are clamped and sorted by x, and those with a NaN coordinate are dropped.
+     */
+    void setPoints(const QVector<QPointF>& p);
+
+    /**
+     * @brief Evaluate a curve at the given abscissa.
+     * @param p Control points sorted by x.
+     * @param x Abscissa; values outside the points are clamped.
+     * @return The interpolated ordinate, clamped to [0, 1].
+     */
+    static double evaluate(const QVector<QPointF>& p, double x);
+
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted when the user edits the points.
+     */
+    void pointsEdited();
+
+protected:
+    void paintEvent(QPaintEvent* e) override;
+
+    void resizeEvent(QResizeEvent* e) override;
+
+    void mousePressEvent(QMouseEvent* e) override;
+
+    void mouseMoveEvent(QMouseEvent* e) override;
+
+    void mouseReleaseEvent(QMouseEvent* e) override;
+
+private:
+    static constexpr double HandleRadius = 4.0; ///< Radius of the point handles, in pixels.
+
+    static double evaluateSegment(const QVector<QPointF>& p, int i, double x);
+
+    static double tangent(const QVector<QPointF>& p, int i);
+
+    QRectF plotRect() const;
+
+    QPointF toWidget(const QPointF& p) const;
+
+    QPointF fromWidget(const QPointF& p) const;
+
+    QRectF handleRect(int i) const;
+
+    int pointAt(const QPoint& pos) const;
+
+    void invalidateAll();
+
+    /**
+     * @brief Sample one segment at about two pixels per step.
+     */
+    void rebuildSegment(int i);
+};
+
+/**
+ * @class CurveParam
+ * @brief Parameter class for 1D transfer curves defined by spline control points.
+ *
+ * The curve maps [0, 1] to [0, 1]; use CurveEditor::evaluate() to sample it.
+ * Points are saved in compact binary form (see PackedFloats).
+ */
+class CurveParam : public ParamBase {
+    Q_OBJECT
+    QVector<QPointF>    * ptr; ///< Pointer to the control points.
+    QVector<QPointF>    defVal; ///< Default control points.
+    CurveEditor         * editor; ///< Curve editor widget.
+
+public:
+    static const int MaxPoints = 4096; ///< Most control points read from a file.
+
+    /**
+     * @brief Constructor for CurveParam.
+     * @param name Parameter name.
+     * @param p Pointer to the control points (in the unit square).
+     * @param def Default control points.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    CurveParam(QString name, QVector<QPointF>* p, QVector<QPointF> def, QString tip, QWidget* parent = nullptr);
+
+    int rowHeightHint() const override { return 160; }
+
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    void trackEdits() override;
+};
+
+/**
+ * @class LutEditor
+ * @brief Interactive editor of a dense 2D lookup table.
+ *
+ * The table is shown through a cached Indexed8 QImage with one pixel per cell.
+ * A brush with Gaussian falloff raises the cells (left button) or lowers them
+ * (right button); each stroke step updates only the cells under the brush, the
+ * matching image pixels and the matching screen area, so editing stays smooth
+ * on 1024x1024 tables. Painting maps the exposed area back to table cells and
+ * draws only that part of the image.
+ */
+class LutEditor : public QWidget {
+    Q_OBJECT
+    int             cols = 0; ///< Table width.
+    int             rows = 0; ///< Table height.
+    float           lo; ///< Value shown with the first colour.
+    float           hi; ///< Value shown with the last colour.
+    QVector<float>  cells; ///< Row-major table values.
+    QImage          image; ///< Cached rendering, one pixel per cell.
+    int             brushRadius = 8; ///< Brush radius in cells.
+    float           brushStrength = 0.05f; ///< Brush change at its centre, as a fraction of the range.
+    QPoint          lastCell; ///< Cell under the brush at the last stroke step.
+
+public:
+    /**
+     * @brief Constructor for LutEditor.
+     * @param min Lowest table value.
+     * @param max Highest table value.
+     * @param parent Parent widget (default: nullptr).
+     */
+    LutEditor(float min, float max, QWidget* parent = nullptr);
+
+    /**
+     * @brief Replace the table.
+     * @param width Table width.
+     * @param height Table height.
+     * @param values Row-major values, width * height of them; NaN becomes the lowest
+     *        value and the others are clamped to the range.
+     */
+    void setTable(int width, int height, const QVector<float>& values);
+
+    /**
+     * @brief Get the row-major table values.
+     */
+    const QVector<float>& values() const { return cells; }
+
+    /**
+     * @brief Set the brush radius.
+     * @param radius Radius in cells.
+     */
+    void setBrushRadius(int radius);
+
+    /**
+     * @brief Set the brush strength.
+     * @param strength Change at the brush centre per step, as a fraction of the range.
+     */
+    void setBrushStrength(double strength);
+
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted at every brush step of the user.
+     */
+    void tableEdited();
+
+    /**
+     * @brief Emitted when the user releases the brush.
+     */
+    void strokeFinished();
+
+protected:
+    void paintEvent(QPaintEvent* e) override;
+
+    void mousePressEvent(QMouseEvent* e) override;
+
+    void mouseMoveEvent(QMouseEvent* e) override;
+
+    void mouseReleaseEvent(QMouseEvent* e) override;
+
+private:
+    QPoint toCell(const QPoint& pos) const;
+
+    /**
+     * @brief Apply one brush step around a cell and refresh only what it touched.
+     */
+    void stroke(const QPoint& centre, bool lower);
+
+    /**
+     * @brief Convert the given cells into image colour indices.
+     */
+    void renderCells(const QRect& area);
+};
+
+/**
+ * @class LutParam
+ * @brief Parameter class for dense 2D lookup tables (up to 1024x1024).
+ *
+ * The table is edited with a brush whose radius and strength are set next to
+ * the view, and saved in compact binary form (see PackedFloats). A stroke
+ * emits changed() at most setMaxRate() times per second, and once more when
+ * the brush is released.
+ *
+ * value() and storedValue() hold a QVector<float> sharing the table, so taking
+ * and comparing them copies nothing while the tables are shared; setValue()
+ * also accepts the raw bytes of the floats.
+ */
+class LutParam : public ParamBase {
+    Q_OBJECT
+    QVector<float>  * ptr; ///< Pointer to the row-major table.
+    QVector<float>  defVal; ///< Default table.
+    int             cols; ///< Table width.
+    int             rows; ///< Table height.
+    LutEditor       * editor; ///< Table editor widget.
+
+public:
+    /**
+     * @brief Constructor for LutParam.
+     * @param name Parameter name.
+     * @param p Pointer to the row-major table; it is resized to width * height.
+     * @param width Table width (at most 1024).
+     * @param height Table height (at most 1024).
+     * @param min Lowest table value.
+     * @param max Highest table value.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    LutParam(QString name, QVector<float>* p, int width, int height, float min, float max, QString tip, QWidget* parent = nullptr);
+
+    /**
+     * @brief Set the maximum rate of changes emitted during a stroke.
+     * @param hz Changes per second (default: 30).
+     */
+    void setMaxRate(double hz) { setGestureRate(hz); }
+
+    int rowHeightHint() const override { return 200; }
+
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    /**
+     * @brief Track table edits only, at a bounded rate; the brush settings are not part of the value.
+     */
+    void trackEdits() override;
+};
+
+/* -------------------------------------
+   Parameter Group Templates
+   ------------------------------------- */
+
+/**
+ * @class ParamGroupTemplate
+ * @brief Names, tooltips, ranges and defaults of a group of numbers, defined once for many instances.
+ *
+ * The field list is implicitly shared: copying a template, as every GroupParam
+ * does, copies a pointer. Forty-eight axes of a ten-field template store the
+ * metadata once and 480 values.
+ */
+class ParamGroupTemplate {
+public:
+    /// Metadata of one field.
+    struct Field {
+        QString key; ///< Attribute name in saved files, a valid XML name.
+        QString label; ///< Text painted before the field, may be empty.
+        QString tip; ///< Tooltip of the field.
+        double  min; ///< Minimum value.
+        double  max; ///< Maximum value.
+        double  step; ///< Step size.
+        double  def; ///< Default value.
+    };
+
+    /**
+     * @brief Constructor for ParamGroupTemplate.
+     * @param decimals Decimals shown for every field (0 for integer fields).
+     */
+    explicit ParamGroupTemplate(int decimals = 2) : dec(decimals) {}
+
+    /**
+     * @brief Append a field.
+     * @param key Attribute name in saved files.
+     * @param label Text painted before the field.
+     * @param min Minimum value.
+     * @param max Maximum value.
+     * @param step Step size.
+     * @param def Default value.
+     * @param tip Tooltip text.
+     * @return Index of the field.
+     */
+    int addField(const QString& key, const QString& label,
+        double min, double max, double step, double def, const QString& tip);
+
+    int fieldCount() const { return fields.size(); } ///< Number of fields.
+    const Field& field(int i) const { return fields.at(i); } ///< Metadata of a field.
+    int decimals() const { return dec; } ///< Decimals shown for every field.
+
+    /**
+     * @brief Get the index of the field with a key, or -1.
+     */
+    int indexOf(const QString& key) const;
+
+    /**
+     * @brief Get the default values of the fields, in field order.
+     */
+    QVector<double> defaults() const;
+
+private:
+    QVector<Field>  fields; ///< Field metadata, shared by all copies.
+    int             dec; ///< Decimals shown for every field.
+};
+
+/**
+ * @class GroupParam
+ * @brief One instance of a ParamGroupTemplate, edited in a single row.
+ *
+ * The instance holds its name, the shared template and one value per field.
+ * The CompoundEditor showing the values is only created when the row is first
+ * laid out (see ParamBase::createWidget()), so instances scrolled out of view
+ * never build a widget. The referenced vector is resized to the field count by
+ * apply().
+ */
+class GroupParam : public ParamBase {
+    Q_OBJECT
+    ParamGroupTemplate  tmpl; ///< Shared field metadata.
+    QVector<double>     * ptr; ///< Pointer to the values, in field order.
+    QVector<double>     shown; ///< Values shown, also while the editor does not exist.
+    CompoundEditor      * editor = nullptr; ///< Editor of the values, created with the row.
+
+public:
+    /**
+     * @brief Constructor for GroupParam.
+     * @param name Instance name, also used as its element name in saved files (e.g. "Axis12").
+     * @param t Template of the instance.
+     * @param p Pointer to the values; missing entries start at the template defaults.
+     * @param parent Parent widget (default: nullptr).
+     */
+    GroupParam(QString name, const ParamGroupTemplate& t, QVector<double>* p, QWidget* parent = nullptr);
+
+    /**
+     * @brief Get the template of the instance.
+     */
+    const ParamGroupTemplate& groupTemplate() const { return tmpl; }
+
+    void apply() override;
+
+    /**
+     * @brief Reset every field to the template default.
+     */
+    void reset() override;
+
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+
+    /**
+     * @brief Write one attribute per field, named by the field key.
+     */
+    void save(QXmlStreamWriter& w) const override;
+
+    /**
+     * @brief Read the fields whose key is present; the others keep their value.
+     */
+    void load(QXmlStreamReader& r) override;
+
+    void createWidget() override;
+
+private:
+    /**
+     * @brief Show a value in a field, clamped to its range; emits changed() if it differs.
+     */
+    void setField(int i, double v);
+};
+
+/* -------------------------------------
+   Record Table Parameter
+   ------------------------------------- */
+
+/**
+ * @struct RecordColumn
+ * @brief Type, range and title of one column of a RecordTableParam.
+ *
+ * Cells hold a bool, an int, a double, a QString, or for choice columns the
+ * int index of the selected option. Build columns with the static helpers.
+ */
+struct RecordColumn {
+    /// Value type of the column, as the parameter of the same kind.
+    enum Type { Bool, Int, Double, String, Choice };
+
+    Type        type = String; ///< Value type.
+    QString     key; ///< Column name in saved files.
+    QString     title; ///< Header text.
+    QString     tip; ///< Tooltip of the header and of the cells.
+    double      min = 0.0; ///< Minimum value (Int and Double).
+    double      max = 0.0; ///< Maximum value (Int and Double).
+    double      step = 1.0; ///< Step size (Int and Double).
+    int         decimals = 2; ///< Decimals shown (Double).
+    QStringList options; ///< Options (Choice).
+
+    static RecordColumn boolColumn(const QString& key, const QString& title, const QString& tip);
+    static RecordColumn intColumn(const QString& key, const QString& title, int min, int max, const QString& tip);
+    static RecordColumn doubleColumn(const QString& key, const QString& title,
+        double min, double max, double step, int decimals, const QString& tip);
+    static RecordColumn stringColumn(const QString& key, const QString& title, const QString& tip);
+    static RecordColumn choiceColumn(const QString& key, const QString& title, const QStringList& options, const QString& tip);
+
+    /**
+     * @brief Value of the column in a new row.
+     */
+    QVariant defaultValue() const;
+
+    /**
+     * @brief Convert a value to the column type and range.
+     */
+    QVariant coerce(const QVariant& v) const;
+};
+
+/**
+ * @class RecordTableParam
+ * @brief Parameter class for tables of records with typed fields (tool tables, recipe steps).
+ *
+ * The referenced vector holds the cells row-major, one per column and row. The
+ * table is shown in a QTableView with fixed row heights, which only lays out
+ * and paints the visible rows; the buttons beside it insert, delete and move
+ * rows. Tables are saved as one attribute of compact rows: fields separated by
+ * ',', rows by ';', with '\' escaping those characters in strings. Columns are
+ * matched by key on load, so adding or reordering columns keeps old files.
+ */
+class RecordTableParam : public ParamBase {
+    Q_OBJECT
+    QVector<QVariant>   * ptr; ///< Pointer to the row-major cells.
+    QVector<QVariant>   defVal; ///< Default cells.
+    RecordTableModel    * model; ///< Cells shown by the table.
+    QTableView          * view; ///< Table view.
+
+public:
+    static const int MaxRows = 1000000; ///< Most rows read from a file.
+
+    /**
+     * @brief Constructor for RecordTableParam.
+     * @param name Parameter name.
+     * @param p Pointer to the row-major cells; a partial last row is dropped.
+     * @param columns Column definitions.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    RecordTableParam(QString name, QVector<QVariant>* p, const QVector<RecordColumn>& columns,
+        QString tip, QWidget* parent = nullptr);
+
+    int rowHeightHint() const override { return 240; }
+
+    void apply() override;
+    void reset() override;
+
+    /**
+     * @brief Get the applied cells as a flat, row-major QVariantList.
+     */
+    QVariant storedValue() const override;
+
+    /**
+     * @brief Get the shown cells as a flat, row-major QVariantList.
+     */
+    QVariant value() const override;
+
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    /**
+     * @brief Track table edits and row insertion, deletion and moves.
+     */
+    void trackEdits() override;
+
+private:
+    /**
+     * @brief Move the current row up or down by one.
+     */
+    void moveCurrent(int delta);
+
+    static QString escaped(const QString& s);
+};
+
+/* -------------------------------------
+   Variant Tree Parameter
+   ------------------------------------- */
+
+/**
+ * @class VariantTreeParam
+ * @brief Parameter class for nested QVariantMap / QVariantList values, such as settings read from JSON.
+ *
+ * The value is shown in a QTreeView over a VariantTreeModel, so opening even a
+ * very large variant creates only the rows of its first level. Values are saved
+ * with their structure and types, as compressed binary text (see encode()) split
+ * over attributes "data", "data1", "data2"... of ChunkLength characters each.
+ */
+class VariantTreeParam : public ParamBase {
+    Q_OBJECT
+    QVariant            * ptr; ///< Pointer to the variant value.
+    QVariant            defVal; ///< Default value.
+    VariantTreeModel    * model; ///< Tree shown by the view.
+    QTreeView           * view; ///< Tree view.
+
+public:
+    static const int MaxDepth = 64; ///< Deepest nesting read from a file.
+    static const int MaxBytes = 256 << 20; ///< Largest uncompressed value read from a file.
+    static const int ChunkLength = 1 << 20; ///< Characters per saved attribute, below LoadLimits::maxAttributeLength.
+
+    /**
+     * @brief Constructor for VariantTreeParam.
+     * @param name Parameter name.
+     * @param p Pointer to the variant value.
+     * @param def Default value.
+     * @param tip Tooltip text.
+     * @param parent Parent widget (default: nullptr).
+     */
+    VariantTreeParam(QString name, QVariant* p, QVariant def, QString tip, QWidget* parent = nullptr);
+
+    int rowHeightHint() const override { return 240; }
+
+    void apply() override;
+    void reset() override;
+    QVariant storedValue() const override;
+    QVariant value() const override;
+    void setValue(const QVariant& v) override;
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+    /**
+     * @brief Track leaf edits and replacements of the tree.
+     */
+    void trackEdits() override;
+
+    /**
+     * @brief Encode a value with its structure and types.
+     *
+     * Maps, hashes, lists and string lists are written as a tag, a count and
+     * their entries; any other value is written with QDataStream, except values
+     * of types registered by the application, which are kept as their text. The
+     * result is compressed and base64 encoded.
+     */
+    static QString encode(const QVariant& v);
+
+    /**
+     * @brief Decode text produced by encode().
+     *
+     * The uncompressed size is checked before anything is inflated, nesting is
+     * limited to MaxDepth and counts are checked against the remaining data.
+     * @param text The base64 text.
+     * @param ok Set to false if the text is malformed or exceeds the limits.
+     */
+    static QVariant decode(const QStringRef& text, bool* ok);
+
+private:
+    /**
+     * @brief Show a value and expand its first level.
+     */
+    void setTree(const QVariant& v);
+
+    static void write(QDataStream& out, const QVariant& v);
+
+    static bool read(QDataStream& in, QVariant& v, int depth);
+};
+
+/* -------------------------------------
+   Audit Log
+   ------------------------------------- */
+
+/**
+ * @class ParamAuditLog
+ * @brief Append-only, rotated log of applied parameter changes.
+ *
+ * record() only stamps the change and pushes it into a lock-free queue; formatting
+ * and file I/O happen on the log's own writer thread, which drains the queue in
+ * batches. Each line holds an ISO 8601 timestamp, the user, the parameter, the old
+ * and the new value, separated by tabs; ParamsEditor writes "***" for both values
+ * of a PasswordParam. When the file would exceed the size limit it is
+ * renamed to "<file>.1" (older files shift up to the configured count) and a new
+ * file is started.
+ *
+ * The writer sleeps until a record arrives. Records that cannot be written are
+ * kept and retried every second, up to the size limit; beyond that they are
+ * counted as lost. Failures are reported by writeFailed(), and records lost or
+ * dropped are noted in the log as soon as it can be written again.
+ *
+ * Usage:
+ * @code
+ * ParamAuditLog audit("changes.log");
+ * audit.start();
+ * editor.setAuditLog(&audit);
+ * @endcode
+ */
+class ParamAuditLog : public QObject {
+    Q_OBJECT
+    std::unique_ptr<ParamAuditWriter> writer; ///< Queue and writer thread, defined in parameditor_p.h.
+    QString         user; ///< User recorded with each change.
+
+public:
+    /**
+     * @brief Constructor for ParamAuditLog.
+     * @param path Path of the log file.
+     * @param maxBytes File size that triggers a rotation (default: 10 MiB).
+     * @param maxFiles Number of rotated files kept (default: 5).
+     * @param capacity Number of records that can be queued (default: 65536).
+     * @param parent Parent object (default: nullptr).
+     */
+    ParamAuditLog(const QString& path, qint64 maxBytes = 10 * 1024 * 1024, int maxFiles = 5,
+        size_t capacity = 65536, QObject* parent = nullptr);
+
+    /**
+     * @brief Destructor; writes the pending records and stops the thread.
+     */
+    ~ParamAuditLog() override;
+
+    /**
+     * @brief Start the writer thread; records queued before are written then.
+     */
+    void start();
+
+    /**
+     * @brief Set the user recorded with the following changes.
+     *
+     * Must be called from the thread that calls record().
+     * @param name User name.
+     */
+    void setUser(const QString& name) { user = name; }
+
+    /**
+     * @brief Queue a change for writing. Never blocks.
+     * @param name Parameter name.
+     * @param oldValue Value before the change.
+     * @param newValue Value after the change.
+     * @return False if the queue was full and the record was dropped.
+     */
+    bool record(const QString& name, const QVariant& oldValue, const QVariant& newValue);
+
+    /**
+     * @brief Write the pending records and stop the writer thread.
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of records dropped because the queue was full.
+     */
+    quint64 droppedCount() const;
+
+    /**
+     * @brief Get the number of records lost because the file could not be written.
+     */
+    quint64 lostCount() const;
+
+    /**
+     * @brief Format a value for the log.
+     * @param v Value to format.
+     */
+    static QString valueText(const QVariant& v);
+
+signals:
+    /**
+     * @brief Emitted when the log cannot be opened, written or rotated.
+     *
+     * Emitted once per distinct failure, queued from the writer thread to the
+     * thread of the log; the records are retried as described above.
+     * @param reason File and cause.
+     */
+    void writeFailed(const QString& reason);
+};
+
+/* -------------------------------------
+   Monitor Parameter
+   ------------------------------------- */
+
+/**
+ * @class MonitorParam
+ * @brief Read-only parameter showing a value measured by the application.
+ *
+ * Any thread may post() samples, at any rate, into a LockFreeQueue; posting
+ * never allocates or blocks. The GUI thread drains the queue once per frame,
+ * shows the latest sample and appends the minimum and maximum of the frame to a
+ * sparkline, so a 1 kHz source costs one repaint per frame. Nothing is repainted
+ * while no samples arrive. The frame timer only runs while the row is visible:
+ * samples posted while it is scrolled out, on another tab or in a hidden window
+ * are discarded without counting as dropped. The measured value is not a value
+ * of the parameter: value() is null, so it is never copied, pasted, saved or
+ * undone; DEF clears the history.
+ */
+class MonitorParam : public ParamBase {
+    Q_OBJECT
+    std::unique_ptr<LockFreeQueue<double>> samples; ///< Samples posted since the last frame.
+    std::atomic<quint64> dropped{ 0 }; ///< Samples dropped because the queue was full.
+    std::atomic<bool>   showing{ false }; ///< True while the row is visible and samples are drained.
+    QLabel              * valueLabel; ///< Latest sample.
+    Sparkline           * sparkline; ///< Recent history.
+    QTimer              * refresh; ///< Drains the samples once per frame.
+    QString             suffix; ///< Text shown after the value.
+    int                 decimals; ///< Digits shown after the decimal point.
+    double              last; ///< Latest sample, NaN before the first one.
+
+public:
+    static const int QueueCapacity = 1024; ///< Samples that can wait for the next frame.
+    static const int RefreshInterval = 16; ///< Milliseconds between frames.
+
+    /**
+     * @brief Constructor for MonitorParam.
+     * @param name Parameter name.
+     * @param suffix Text shown after the value (e.g. " degC").
+     * @param decimals Digits shown after the decimal point.
+     * @param tip Tooltip text.
+     * @param history Number of frames shown by the sparkline (default: 120, two seconds).
+     * @param parent Parent widget (default: nullptr).
+     */
+    MonitorParam(QString name, QString suffix, int decimals, QString tip, int history = 120, QWidget* parent = nullptr);
+
+    ~MonitorParam() override;
+
+    /**
+     * @brief Post a sample; safe from any thread, never blocks or allocates.
+     * @param v Sample value; discarded while the row is hidden.
+     * @return False if the sample was dropped because the queue was full.
+     */
+    bool post(double v);
+
+    /**
+     * @brief Get the number of samples dropped because the queue was full.
+     */
+    quint64 droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    void apply() override;
+    void reset() override;
+    QVariant value() const override { return QVariant(); }
+    void save(QXmlStreamWriter& w) const override;
+    void load(QXmlStreamReader& r) override;
+
+protected:
+    void showEvent(QShowEvent* e) override;
+    void hideEvent(QHideEvent* e) override;
+
+private slots:
+    /**
+     * @brief Drain the posted samples and update the label and the sparkline.
+     */
+    void refreshDisplay();
+};
+
+/* -------------------------------------
+   Shared Value Store
+   ------------------------------------- */
+
+/**
+ * @class ParamStore
+ * @brief Values and metadata shared by several editor views.
+ *
+ * Each entry holds one copy of its value and a factory that keeps the
+ * parameter's metadata (range, step, tooltip...) once. Every view of an entry,
+ * added with ParamsEditor::addStoreParam(), is a parameter referencing that same
+ * value. A committed edit in any view is shown at once by the other views, with
+ * their signals blocked, but the value is only written when the editing view is
+ * applied: cancelling its editor leaves the value as it was, and the audit log
+ * sees the change. Applying refreshes the other views and emits valueChanged()
+ * once.
+ *
+ * Each view shares the ownership of its value, so a view outliving the store
+ * still references valid memory; it no longer follows the other views.
+ *
+ * @code
+ * ParamStore store;
+ * const int gain = store.add<DoubleParam>("Gain", 0.5, 0.0, 1.0, 0.01, QString("Output gain"));
+ * quick.addStoreParam(quickTab, &store, "Gain");
+ * full.addStoreParam(fullTab, &store, "Gain");
+ * double g = store.get<double>(gain);
+ * @endcode
+ * Use from the GUI thread only.
+ */
+class ParamStore : public QObject {
+    Q_OBJECT
+
+    /// One shared value.
+    struct Entry {
+        QString                         key; ///< Name of the entry, also the name of its views.
+        std::shared_ptr<void>           slot; ///< The value, also owned by every view.
+        int                             type; ///< Meta-type id of the value.
+        std::function<ParamBase*()>     create; ///< Builds a view; holds the metadata.
+        std::function<QVariant()>       read; ///< Reads the value as a QVariant.
+        QVector<QPointer<ParamBase>>    views; ///< Views created so far.
+    };
+
+    QVector<Entry>      entries; ///< Entries in order of addition.
+    QHash<QString, int> handles; ///< Entry index by key.
+
+public:
+    /**
+     * @brief Constructor for ParamStore.
+     * @param parent Parent object (default: nullptr).
+     */
+    explicit ParamStore(QObject* parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief Add an entry edited by parameters of type P.
+     *
+     * Views are created as P(key, &value, args...), so args are the arguments
+     * of the P constructor that follow the value pointer.
+     * @param key Entry name; must be unique in the store.
+     * @param initial Initial value.
+     * @param args Remaining constructor arguments of P, stored once.
+     * @return Handle of the entry, or -1 if the key is already used.
+     */
+    template<typename P, typename T, typename... Args>
+    int add(const QString& key, const T& initial, Args... args) {
+        if (handles.contains(key)) return -1;
+        std::shared_ptr<T> value = std::make_shared<T>(initial);
+        Entry e;
+        e.key = key;
+        e.slot = value;
+        e.type = qMetaTypeId<T>();
+        e.create = [key, value, args...]() -> ParamBase* { return new P(key, value.get(), args...); };
+        e.read = [value]() { return QVariant::fromValue(*value); };
+        entries.append(e);
+        handles.insert(key, entries.size() - 1);
+        return entries.size() - 1;
+    }
+
+    /**
+     * @brief Get the handle of an entry, or -1.
+     */
+    int handle(const QString& key) const { return handles.value(key, -1); }
+
+    int count() const { return entries.size(); } ///< Number of entries.
+    QString key(int handle) const { return entries.at(handle).key; } ///< Name of an entry.
+
+    /**
+     * @brief Get the value of an entry as a QVariant.
+     */
+    QVariant value(int handle) const;
+
+    /**
+     * @brief Get the value of an entry.
+     * @tparam T The type the entry was added with.
+     */
+    template<typename T>
+    const T& get(int handle) const {
+        Q_ASSERT(entries.at(handle).type == qMetaTypeId<T>());
+        return *static_cast<const T*>(entries.at(handle).slot.get());
+    }
+
+    /**
+     * @brief Set the value of an entry, refreshing every view and emitting valueChanged().
+     * @tparam T The type the entry was added with.
+     */
+    template<typename T>
+    void set(int handle, const T& v) {
+        Q_ASSERT(entries.at(handle).type == qMetaTypeId<T>());
+        *static_cast<T*>(entries[handle].slot.get()) = v;
+        refresh(handle, nullptr);
+    }
+
+    /**
+     * @brief Create a new view of an entry, referencing the shared value.
+     *
+     * Used by ParamsEditor::addStoreParam(); the caller owns the view, which
+     * keeps the value alive until it is destroyed.
+     * @return The view, or nullptr if the handle is invalid.
+     */
+    ParamBase* createView(int handle);
+
+signals:
+    /**
+     * @brief Emitted once per written change of an entry: a view applied, or set().
+     * @param handle Handle of the entry.
+     */
+    void valueChanged(int handle);
+
+private:
+    /**
+     * @brief Show the value being edited in a view in every other view of the entry.
+     */
+    void mirror(int handle, ParamBase* source);
+
+    /**
+     * @brief Show the shared value in every view but source, then emit valueChanged().
+     */
+    void refresh(int handle, ParamBase* source);
+};
+
+/* -------------------------------------
+   Latency Instrumentation
+   ------------------------------------- */
+
+/**
+ * @class LatencyHistogram
+ * @brief Fixed-size log-linear histogram of durations in nanoseconds.
+ *
+ * Values below 2 * SubBuckets are counted exactly; above, every power of two is
+ * split in SubBuckets buckets, so a recorded value is off by at most 1/SubBuckets
+ * (about 3%). Values beyond the last bucket (about 73 minutes) are clamped.
+ * Recording never allocates.
+ */
+class LatencyHistogram {
+public:
+    static const int SubBuckets = 32; ///< Buckets per power of two.
+    static const int MaxShift = 36; ///< Highest recorded value is 2^(MaxShift + 6) - 1 ns.
+    static const int BucketCount = (MaxShift + 2) * SubBuckets; ///< Number of buckets.
+
+    /**
+     * @brief Count a duration.
+     * @param ns Duration in nanoseconds; negative values count as zero.
+     */
+    void record(qint64 ns);
+
+    /**
+     * @brief Forget all recorded values.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of recorded values.
+     */
+    quint64 count() const { return total; }
+
+    /**
+     * @brief Get the lowest recorded value, 0 if none.
+     */
+    qint64 min() const { return total ? lowest : 0; }
+
+    /**
+     * @brief Get the highest recorded value, 0 if none.
+     */
+    qint64 max() const { return highest; }
+
+    /**
+     * @brief Get the mean of the recorded values, 0 if none.
+     */
+    double mean() const { return total ? sum / double(total) : 0.0; }
+
+    /**
+     * @brief Get the value below which a share of the recorded values fall.
+     * @param percentile Share in percent, 0 to 100.
+     * @return Upper bound of the bucket holding that value, never above max().
+     */
+    qint64 valueAt(double percentile) const;
+
+private:
+    static int bucketOf(quint64 v);
+
+    static qint64 bucketHigh(int index);
+
+    quint64     buckets[BucketCount] = {}; ///< Count per bucket.
+    quint64     total = 0; ///< Number of recorded values.
+    qint64      lowest = 0; ///< Lowest recorded value.
+    qint64      highest = 0; ///< Highest recorded value.
+    double      sum = 0.0; ///< Sum of the recorded values, for the mean.
+};
+
+/**
+ * @class ParamLatency
+ * @brief Optional measurement of the latency from an edit to its consumers.
+ *
+ * Off by default. When enabled, the operator's latest input on a parameter
+ * stamps it: a keystroke, Enter or focus-out in a text field, the Apply button
+ * for an edit still pending, or a change of another widget while the focus is
+ * in the row. The time elapsed since is recorded at three stages:
+ * - Commit: the parameter emits changed(), after the debounce delay if any;
+ * - Apply: the value is written to the referenced variable;
+ * - Publish: applied() has been emitted, so bound properties and listeners hold
+ *   the value. This ends the measurement.
+ *
+ * Apply and Publish are only recorded for a commit applied at once, with live
+ * apply (ParamsEditor::setLiveApply()); otherwise the stamp ends at Commit, and
+ * a later Apply click is an input of its own, not a latency of the edit. So
+ * typing "12345" with per-keystroke commits records five commits, each timed
+ * from its own keystroke, and waiting before pressing Apply is never counted.
+ *
+ * Values set by code carry no stamp and are not measured. Durations are kept
+ * per parameter type (class name) and stage in LatencyHistogram instances,
+ * created at the first measured edit of a type. The stages are recorded by
+ * ParamsEditor; ParamStore views are measured through the editor showing them.
+ * GUI thread only.
+ *
+ * @code
+ * ParamLatency::setEnabled(true);
+ * // ... operator session ...
+ * ParamLatency::exportCsv("latency.csv");
+ * @endcode
+ */
+class ParamLatency {
+public:
+    /**
+     * @brief Measured stages of an edit.
+     */
+    enum Stage {
+        Commit, ///< The parameter emitted changed().
+        Apply, ///< The value was written to the referenced variable.
+        Publish, ///< Listeners and bound properties were notified.
+        StageCount ///< Number of stages.
+    };
+
+    /**
+     * @brief Enable or disable the measurement; edits started before enabling are not recorded.
+     */
+    static void setEnabled(bool on);
+
+    /**
+     * @brief Check if the measurement is enabled.
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Stamp an input of the operator on a parameter, replacing an older stamp.
+     * @param param Parameter receiving the input.
+     */
+    static void input(ParamBase* param);
+
+    /**
+     * @brief Record a committed change, stamping it first if the operator made it.
+     *
+     * A change is the operator's when the focus is in the parameter's row; this
+     * covers check boxes, combo boxes and buttons, which commit without typing.
+     * @param param Changed parameter.
+     * @param flushed Whether the change is applied in the same pass; if not, the
+     *        stamp is cleared after Commit.
+     */
+    static void committed(ParamBase* param, bool flushed);
+
+    /**
+     * @brief Record the time since the edit started at a stage.
+     * @param param Parameter of the edit; nothing is recorded if it has no stamp.
+     * @param stage Reached stage; Publish clears the stamp.
+     */
+    static void record(ParamBase* param, Stage stage);
+
+    /**
+     * @brief Get the measured parameter types, sorted.
+     */
+    static QStringList types();
+
+    /**
+     * @brief Get the histogram of a type at a stage.
+     * @return The histogram, or nullptr if the type was never measured.
+     */
+    static const LatencyHistogram* histogram(const QString& type, Stage stage);
+
+    /**
+     * @brief Get the name of a stage, as used by toCsv().
+     */
+    static QString stageName(Stage stage);
+
+    /**
+     * @brief Summarize all histograms as CSV, one line per type and stage, times in microseconds.
+     */
+    static QString toCsv();
+
+    /**
+     * @brief Write toCsv() to a file.
+     * @return False if the file cannot be written.
+     */
+    static bool exportCsv(const QString& path);
+
+    /**
+     * @brief Forget all recorded values.
+     */
+    static void clear();
+};
+
+/* -------------------------------------
+   Main Editor Dialog Class
+   ------------------------------------- */
+
+/**
+ * @struct LoadLimits
+ * @brief Bounds on the XML read by ParamsEditor, so that a malformed or hostile
+ * file is rejected early instead of stalling the GUI.
+ *
+ * A limit of 0 disables the corresponding check. The defaults leave room for
+ * the largest lookup table (1024x1024) while capping a file at a parse time of
+ * well under a second.
+ */
+struct LoadLimits {
+    qint64  maxFileSize = 32 * 1024 * 1024; ///< Largest file accepted, in bytes.
+    int     maxElements = 100000; ///< Most elements read from one file.
+    int     maxAttributeLength = 8 * 1024 * 1024; ///< Longest attribute value, in characters.
+    int     maxDepth = 16; ///< Deepest element nesting, the root element included.
+};
+
+/**
+* @class ParamsEditor
+* @brief Main parameter editor dialog container
+*
+* Features:
+* - Tab-based organization
+* - Apply/Cancel semantics
+* - XML import/export with resource limits on the input
+* - Clipboard copy/paste with undo
+* - Optional audit log of applied changes
+* - Optional live apply of every change
+* - Commit policy for text edits: per keystroke (debounced), on Enter or on focus-out
+* - Thread-safe posting of values from producer threads
+* - Read-only monitored values with sparklines
+* - Unit-aware numeric values with per-editor display units
+* - Integrated help system
+* - Automatic UI layout
+* - Scrollable pages that only lay out visible rows
+*
+* Usage workflow:
+* 1. Create ParamsEditor instance
+* 2. Add tabs with addTab()
+* 3. Add parameters to tabs with addParam()
+* 4. Optionally set help content
+* 5. Call show() to display
+*
+* Serialization example:
+* @code
+* // Save configuration
+* editor.saveToFile("settings.xml");
+*
+* // Load configuration
+* editor.loadFromFile("settings.xml");
+* @endcode
+*/
+
+class ParamsEditor : public QDialog {
+    Q_OBJECT
+    QTabWidget      * tabs; ///< Tab widget for organizing parameters.
+    QTextBrowser    * helpBrowser = nullptr; ///< Browser for displaying help text.
+    QVector<QVector<ParamBase*>> allParams; ///< List of parameters per tab.
+    QVector<ParamPage*> pages; ///< Scrollable page of each parameter tab.
+    QMultiHash<QString, ParamBase*> paramIndex; ///< Parameters by name.
+    QUndoStack      * undo; ///< Undo stack for batched value changes.
+    QSet<ParamBase*> editedParams; ///< Parameters changed since the last Apply.
+    ParamAuditLog   * auditLog = nullptr; ///< Optional log of applied changes.
+    QSet<ParamBase*> invalidParams; ///< Parameters whose value cannot be applied.
+    bool            liveApply = false; ///< True if changes are applied as they happen.
+    ParamBase::CommitPolicy commitPolicy = ParamBase::CommitPerKeystroke; ///< When text edits become changes.
+    int             commitDebounce = 0; ///< Debounce delay of CommitPerKeystroke, in milliseconds.
+    QHash<QString, UnitConversion> displayUnits; ///< Display unit chosen for each dimension.
+    LoadLimits      limits; ///< Bounds on the XML read by loadFromFile() and paste().
+
+    /// A value posted from another thread.
+    struct PostedValue {
+        int         handle = -1; ///< Handle of the target parameter.
+        QVariant    value; ///< New widget value.
+    };
+
+    QVector<QPointer<ParamBase>> postTargets; ///< Parameters by handle, see paramHandle().
+    std::unique_ptr<LockFreeQueue<PostedValue>> postQueue; ///< Values posted by other threads.
+    std::atomic<quint64> droppedPosts{ 0 }; ///< Values dropped because the queue was full.
+    QVector<QVariant> pendingPosts; ///< Latest drained value by handle, invalid if none.
+    QVector<int>    pendingHandles; ///< Handles with a pending value, in arrival order.
+    QTimer          * postTimer = nullptr; ///< Drains the posted values once per frame.
+    QString         lastLoadError; ///< Why the last load was rejected, empty if it succeeded.
+    QString         lastSaveError; ///< Why the last save failed, empty if it succeeded.
+    QPushButton     * applyBtn; ///< Button to apply changes.
+    QPushButton     * cancelBtn; ///< Button to cancel changes.
+    bool helpTabCreated = false; ///< Flag if help tab was created.
+
+    static const quint32 ClipboardMagic = 0x50454450; ///< "PEDP", tags clipboard payloads.
+    static const quint16 ClipboardVersion = 1; ///< Version of the clipboard payload.
+    static const int PostQueueCapacity = 4096; ///< Values that can wait for the next frame.
+    static const int PostInterval = 16; ///< Milliseconds between drains of posted values.
+
+public:
+    ParamsEditor(QWidget* parent = nullptr);
+
+    /**
+     * @brief Destructor; deletes the parameters while the editor state they report to is alive.
+     */
+    ~ParamsEditor() override;
+
+    /**
+     * @brief Add a new tab to the editor.
+     * @param title Tab title.
+     * @param icon Tab icon (default: empty).
+     * @return Index of the new tab.
+     */
+    int addTab(const QString& title, const QIcon& icon = QIcon());
+
+    /**
+     * @brief Add a parameter to a tab.
+     *
+     * The row is laid out lazily, the first time it scrolls into view.
+     * @param tabIndex Index of the tab.
+     * @param param Pointer to the parameter object; the editor takes ownership.
+     */
+    void addParam(int tabIndex, ParamBase* param);
+
+    /**
+     * @brief Add a view of a ParamStore entry to a tab.
+     *
+     * The view references the store's value: committed edits write it at once
+     * and show up in the other views of the entry (see ParamStore).
+     * @param tabIndex Index of the tab.
+     * @param store Store holding the entry; must outlive the editor.
+     * @param key Name of the entry.
+     * @return The new parameter, or nullptr if the store has no such entry.
+     */
+    ParamBase* addStoreParam(int tabIndex, ParamStore* store, const QString& key);
+
+    /**
+     * @brief Record every change applied from now on in an audit log.
+     *
+     * On Apply, each edited parameter whose stored value changes costs one
+     * enqueue; the log writes on its own thread.
+     * @param log Audit log (not owned), or nullptr to stop auditing.
+     */
+    void setAuditLog(ParamAuditLog* log) { auditLog = log; }
+
+    /**
+     * @brief Apply each change as soon as it happens instead of on Apply.
+     *
+     * Every ParamBase::changed() applies the parameter and emits
+     * ParamBase::applied(), so bound variables and properties follow the widgets.
+     * @param enabled True to enable live apply.
+     */
+    void setLiveApply(bool enabled) { liveApply = enabled; }
+
+    /**
+     * @brief Choose when text edits become committed changes, for every parameter without its own policy.
+     *
+     * Edited state, live apply, undo and the persistence backends only see
+     * committed values, so with CommitOnEnter typing "12345" is one change
+     * instead of five. Apply commits pending edits first.
+     * @param policy Commit policy (InheritCommit means CommitPerKeystroke).
+     * @param debounceMs Delay after the last keystroke for CommitPerKeystroke, in milliseconds.
+     */
+    void setCommitPolicy(ParamBase::CommitPolicy policy, int debounceMs = 0);
+
+    /**
+     * @brief Apply all parameters, as the Apply button does, without closing the dialog.
+     * @return False, with nothing applied, if some parameter is invalid.
+     */
+    bool applyAll();
+
+    /**
+     * @brief Get the handle through which other threads post values to a parameter.
+     *
+     * Call from the GUI thread before the producers start: the first call sets
+     * up the queue, which is drained once per frame while the editor is shown.
+     * @param param Parameter added to this editor.
+     * @return Handle for postValue(), or -1 if the parameter is not in the editor.
+     */
+    int paramHandle(const ParamBase* param);
+
+    /**
+     * @brief Post a new widget value for a parameter; safe from any thread and never blocks.
+     *
+     * Values wait in a lock-free queue. Once per frame the GUI thread drains it
+     * and sets only the latest value of each parameter, as setValue() would, so
+     * the change counts as an edit (and is applied at once with live apply).
+     * While the editor is hidden nothing is drained: the queue is drained when
+     * it is shown again, and values posted once it is full are dropped, so a
+     * producer that must not lose its last value reposts it.
+     * Producers must stop posting before the editor is destroyed.
+     * @param handle Handle from paramHandle().
+     * @param value New value.
+     * @return False if the value was dropped because the queue was full or no handle was requested yet.
+     */
+    bool postValue(int handle, const QVariant& value);
+
+    /**
+     * @brief Get the number of posted values dropped because the queue was full.
+     */
+    quint64 droppedPostCount() const { return droppedPosts.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Show every parameter of a dimension in the given unit.
+     *
+     * The unit is resolved once and the widgets are refreshed in a single batch
+     * with updates disabled. Values stay canonical; nothing is marked as edited.
+     * Parameters added later with the same dimension use the unit as well.
+     * @param dimension Physical dimension (e.g. "length").
+     * @param unit Unit symbol defined in ParamUnits.
+     */
+    void setDisplayUnit(const QString& dimension, const QString& unit);
+
+    /**
+     * @brief Get the display unit of a dimension (empty for the canonical unit).
+     */
+    QString displayUnit(const QString& dimension) const;
+
+    /**
+     * @brief Check whether the row of a parameter has already been laid out.
+     * @param param Parameter to check.
+     */
+    static bool isRealized(const ParamBase* param);
+
+    /**
+     * @brief Get the number of parameter tabs (the Help tab is not counted).
+     */
+    int tabCount() const;
+
+    /**
+     * @brief Get the title of a tab.
+     * @param tabIndex Index of the tab.
+     */
+    QString tabTitle(int tabIndex) const;
+
+    /**
+     * @brief Get the parameters of a tab in display order.
+     * @param tabIndex Index of the tab.
+     */
+    QVector<ParamBase*> params(int tabIndex) const;
+
+    /**
+     * @brief Find a parameter by name.
+     * @param name Parameter name.
+     * @return The parameter, or nullptr if no parameter has this name.
+     */
+    ParamBase* findParam(const QString& name) const;
+
+    /**
+     * @brief Get the undo stack holding batched value changes.
+     */
+    QUndoStack* undoStack() const { return undo; }
+
+    /**
+     * @brief MIME type of the compact clipboard format.
+     */
+    static QString mimeType();
+
+    /**
+     * @brief Encode parameter values for the clipboard or drag and drop.
+     *
+     * The typed payload is a compressed QDataStream of name/value pairs; the text
+     * fallback is the same XML that saveToFile() writes.
+     * @param params Parameters to encode; those without value() support and PasswordParam are skipped.
+     * @return New mime data owned by the caller.
+     */
+    QMimeData* createMimeData(const QVector<ParamBase*>& params) const;
+
+    /**
+     * @brief Paste values into the parameters with matching names.
+     *
+     * All values are set in a single undoable step.
+     * @param mime Mime data in the compact format or the XML text fallback.
+     * @return Number of parameters updated.
+     */
+    int pasteMimeData(const QMimeData* mime);
+
+    /**
+     * @brief Copy the values of some parameters to the clipboard.
+     * @param params Parameters to copy.
+     */
+    void copyParams(const QVector<ParamBase*>& params);
+
+    /**
+     * @brief Copy all parameters of a tab to the clipboard.
+     * @param tabIndex Index of the tab.
+     */
+    void copyTab(int tabIndex);
+
+    /**
+     * @brief Copy the selected rows of the current tab, or the whole tab if none is selected.
+     */
+    void copySelection();
+
+    /**
+     * @brief Paste parameter values from the clipboard.
+     * @return Number of parameters updated.
+     */
+    int paste();
+
+    /**
+    * @brief Set the main help text for the Help tab.
+    * @param htmlText HTML-formatted help text.
+    */
+    void setMainHelp(const QString& htmlText);
+
+    /**
+     * @brief Set the bounds applied when reading parameter files and pasted XML.
+     * @param l New limits.
+     */
+    void setLoadLimits(const LoadLimits& l) { limits = l; }
+
+    /**
+     * @brief Get the bounds applied when reading parameter files and pasted XML.
+     */
+    LoadLimits loadLimits() const { return limits; }
+
+    /**
+     * @brief Get the reason the last loadFromFile() or loadFromData() failed.
+     * @return File, line and cause, or an empty string if the last load succeeded.
+     */
+    QString loadError() const { return lastLoadError; }
+
+    /**
+     * @brief Load parameters from an XML file.
+     *
+     * Reading stops at the first error or exceeded limit (see setLoadLimits());
+     * values read before that point stay set. A "base" snapshot named by the
+     * root element is read first; it must be a relative path that stays inside
+     * the directory of this file.
+     * @param filename Path to the XML file.
+     * @return False if the file could not be read completely, see loadError().
+     */
+    bool loadFromFile(const QString& filename);
+
+    /**
+     * @brief Load parameters from XML held in memory.
+     *
+     * Same as loadFromFile(), except that a "base" snapshot is not followed.
+     * @param data XML in the format written by saveToFile().
+     * @return False if the data could not be read completely, see loadError().
+     */
+    bool loadFromData(const QByteArray& data);
+
+    /**
+     * @brief Save parameters to an XML file.
+     *
+     * The file is replaced only once completely written, and only if it is
+     * within the file size of the load limits, so that loadFromFile() can read
+     * it back; otherwise the previous file is kept.
+     * @param filename Path to the XML file.
+     * @return False if the file was not written, see saveError().
+     */
+    bool saveToFile(const QString& filename);
+
+    /**
+     * @brief Get the reason the last saveToFile() failed.
+     * @return File and cause, or an empty string if the last save succeeded.
+     */
+    QString saveError() const { return lastSaveError; }
+
+protected:
+    /**
+     * @brief Drain the posted values, then drain them once per frame while shown.
+     */
+    void showEvent(QShowEvent* e) override;
+
+    /**
+     * @brief Stop draining the posted values until the editor is shown again.
+     */
+    void hideEvent(QHideEvent* e) override;
+
+private:
+    /**
+     * @brief Load a file, first loading the snapshot its root element refers to.
+     *
+     * Delta files written by ParamSweep carry a "base" attribute on the root
+     * element naming a full snapshot relative to the file's directory. A base
+     * given as an absolute path, or resolving outside topDir (symbolic links
+     * followed), is rejected.
+     * @param filename Path to the XML file.
+     * @param depth Number of base files already followed.
+     * @param topDir Canonical directory of the file loadFromFile() was given.
+     * @return False on error, with lastLoadError set.
+     */
+    bool loadFromFile(const QString& filename, int depth, const QString& topDir);
+
+    /**
+     * @brief Read parameter values from a device within the load limits.
+     * @param device Open device to read.
+     * @param filename Name used in error messages and to resolve a "base" file,
+     * or empty to ignore the base.
+     * @param depth Number of base files already followed.
+     * @param topDir Canonical directory base files must stay in.
+     * @return False on error, with lastLoadError set.
+     */
+    bool loadFromDevice(QIODevice* device, const QString& filename, int depth, const QString& topDir);
+
+public:
+    /**
+     * @brief Show the dialog with a custom title and icon.
+     * @param windowTitle Title of the dialog (default: "Params Editor").
+     * @param icon Icon for the dialog (default: empty).
+     */
+    void show(const QString& windowTitle = "Params Editor", const QIcon& icon = QIcon());
+
+signals:
+    /**
+     * @brief Emitted after a parameter has been added to a tab.
+     * @param tabIndex Index of the tab.
+     * @param param The new parameter.
+     */
+    void paramAdded(int tabIndex, ParamBase* param);
+
+    /**
+     * @brief Emitted when the row of a parameter is laid out for the first time.
+     * @param param Parameter whose row was realized.
+     */
+    void paramRealized(ParamBase* param);
+
+    /**
+     * @brief Emitted when Apply is clicked, before the parameters are applied.
+     */
+    void applying();
+
+    /**
+     * @brief Emitted after all parameters have been applied.
+     */
+    void applied();
+
+private slots:
+    /**
+     * @brief Show the clipboard menu of a tab.
+     * @param tabIndex Index of the tab.
+     * @param globalPos Position of the menu.
+     */
+    void showContextMenu(int tabIndex, const QPoint& globalPos);
+
+    /**
+     * @brief Handle the Apply button click.
+     */
+    void onApplyClicked();
+
+    /**
+     * @brief Apply one parameter, audit the change and notify its bindings.
+     * @param tab Index of the parameter's tab.
+     * @param param Parameter to apply.
+     */
+    void applyParam(int tab, ParamBase* param);
+
+    /**
+     * @brief Set the values posted since the last frame, the latest one per parameter.
+     */
+    void drainPostedValues();
+
+    /**
+     * @brief Track a parameter's validity and enable Apply only if all are valid.
+     */
+    void setParamValid(ParamBase* param, bool valid);
+
+    /**
+     * @brief Handle the Cancel button click.
+     */
+    void onCancelClicked();
+};
+
+/* -------------------------------------
+   Parameter Sweep Generator
+   ------------------------------------- */
+
+/**
+ * @class ParamSweep
+ * @brief Generates design-of-experiments variants of the parameters of an editor.
+ *
+ * Numeric axes (DoubleParam, IntParam and either bound of a RangeParam) are
+ * sampled on a full grid, uniformly at random or with Latin-hypercube sampling,
+ * always inside the limits of the parameter's widget. run() writes the current
+ * editor state once as "base.xml" and every variant as a small delta file whose
+ * root element refers to the base; ParamsEditor::loadFromFile() follows that
+ * reference. Variants are computed independently from their index, so they are
+ * written in parallel on all cores, and a "manifest.csv" lists the sampled values.
+ *
+ * Usage:
+ * @code
+ * ParamSweep sweep(&editor);
+ * sweep.addRange(gainParam, 0.5, 2.0, 4);
+ * sweep.addRange(countParam, 1, 8);
+ * sweep.setSampling(ParamSweep::LatinHypercube);
+ * sweep.setCount(100000);
+ * sweep.run("doe_run_01");
+ * @endcode
+ */
+class ParamSweep {
+public:
+    /// Sampling strategy.
+    enum Sampling {
+        Grid,           ///< Every combination of the axis levels.
+        Random,         ///< Independent uniform samples.
+        LatinHypercube  ///< One sample per stratum and axis, randomly paired.
+    };
+
+    /// Bound of a RangeParam swept by an axis.
+    enum RangeBound { Lower, Upper };
+
+private:
+    /// One swept attribute.
+    struct Axis {
+        QString         element; ///< Name of the parameter element.
+        QString         attribute; ///< Attribute holding the value.
+        bool            integer = false; ///< True if values are rounded to integers.
+        double          lo = 0; ///< Lowest value.
+        double          hi = 0; ///< Highest value.
+        int             levels = 0; ///< Grid levels when no value list is given.
+        QVector<double> values; ///< Explicit values, if any.
+    };
+
+    /// Attributes written unchanged next to a swept attribute of the same element.
+    struct Fixed {
+        QString element;
+        QString attribute;
+        QString value;
+    };
+
+    ParamsEditor    * editor; ///< Editor providing the base snapshot.
+    QVector<Axis>   axes; ///< Swept attributes.
+    QVector<Fixed>  fixed; ///< Attributes required alongside swept ones.
+    Sampling        sampling = Grid; ///< Sampling strategy.
+    int             count = 0; ///< Number of variants for Random and LatinHypercube.
+    quint64         seed = 1; ///< Seed of the random sampling.
+
+public:
+    static const int MaxVariants = 1 << 24; ///< Most variants run() writes.
+
+    /**
+     * @brief Constructor for ParamSweep.
+     * @param editor Editor whose current values form the base snapshot.
+     */
+    explicit ParamSweep(ParamsEditor* editor) : editor(editor) {}
+
+    /**
+     * @brief Set the sampling strategy (default: Grid).
+     */
+    void setSampling(Sampling s) { sampling = s; }
+
+    /**
+     * @brief Set the number of variants for Random and LatinHypercube sampling.
+     */
+    void setCount(int n);
+
+    /**
+     * @brief Set the seed of the random sampling.
+     */
+    void setSeed(quint64 s) { seed = s; }
+
+    /**
+     * @brief Sweep a DoubleParam between two values.
+     * @param param Parameter to sweep.
+     * @param from Lowest value, clamped to the widget range.
+     * @param to Highest value, clamped to the widget range.
+     * @param levels Number of grid levels (ignored by random sampling).
+     */
+    void addRange(DoubleParam* param, double from, double to, int levels);
+
+    /**
+     * @brief Sweep an IntParam between two values.
+     * @param param Parameter to sweep.
+     * @param from Lowest value, clamped to the widget range.
+     * @param to Highest value, clamped to the widget range.
+     * @param levels Number of grid levels; 0 uses every integer in the range.
+     */
+    void addRange(IntParam* param, int from, int to, int levels = 0);
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("width", QString::number(widthSpin->value()));
-        w.writeAttribute("height", QString::number(heightSpin->value()));
-        w.writeEndElement();
-    }
+    /**
+     * @brief Sweep one bound of a RangeParam between two values.
+     * @param param Parameter to sweep.
+     * @param bound Bound to sweep; the other keeps its current value unless swept too.
+     * @param from Lowest value, clamped to the widget range.
+     * @param to Highest value, clamped to the widget range.
+     * @param levels Number of grid levels (ignored by random sampling).
+     */
+    void addRange(RangeParam* param, RangeBound bound, double from, double to, int levels);
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("width") && r.attributes().hasAttribute("height")) {
-            widthSpin->setValue(r.attributes().value("width").toInt());
-            heightSpin->setValue(r.attributes().value("height").toInt());
-        }
-        r.readNext();
-    }
-};
+    /**
+     * @brief Sweep a DoubleParam over a list of values.
+     */
+    void addValues(DoubleParam* param, const QVector<double>& values);
 
-/**
- * @class RectParam
- * @brief Parameter class for handling rectangle values.
- */
-class RectParam : public ParamBase {
-    Q_OBJECT
-    QRect       * ptr; ///< Pointer to the rectangle value.
-    QRect       defVal; ///< Default rectangle value.
-    QSpinBox    * xSpin; ///< Spin box for x coordinate.
-    QSpinBox    * ySpin; ///< Spin box for y coordinate.
-    QSpinBox    * widthSpin; ///< Spin box for width.
-    QSpinBox    * heightSpin; ///< Spin box for height.
+    /**
+     * @brief Sweep an IntParam over a list of values.
+     */
+    void addValues(IntParam* param, const QVector<int>& values);
 
-public:
     /**
-     * @brief Constructor for RectParam.
-     * @param name Parameter name.
-     * @param p Pointer to the rectangle value.
-     * @param def Default rectangle.
-     * @param tip Tooltip text.
-     * @param parent Parent widget (default: nullptr).
+     * @brief Sweep one bound of a RangeParam over a list of values.
      */
-    RectParam(QString name, QRect* p, QRect def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-
-        QWidget* container = new QWidget(this);
-        QHBoxLayout* layout = new QHBoxLayout(container);
-        layout->setContentsMargins(0, 0, 0, 0);
-
-        xSpin = new QSpinBox;
-        xSpin->setRange(INT_MIN, INT_MAX);
-        xSpin->setValue(p->x());
-        xSpin->setToolTip(tip + " (X coordinate)");
-
-        ySpin = new QSpinBox;
-        ySpin->setRange(INT_MIN, INT_MAX);
-        ySpin->setValue(p->y());
-        ySpin->setToolTip(tip + " (Y coordinate)");
-
-        widthSpin = new QSpinBox;
-        widthSpin->setRange(0, INT_MAX);
-        widthSpin->setValue(p->width());
-        widthSpin->setToolTip(tip + " (Width)");
-
-        heightSpin = new QSpinBox;
-        heightSpin->setRange(0, INT_MAX);
-        heightSpin->setValue(p->height());
-        heightSpin->setToolTip(tip + " (Height)");
-
-        layout->addWidget(new QLabel("X:"));
-        layout->addWidget(xSpin);
-        layout->addWidget(new QLabel("Y:"));
-        layout->addWidget(ySpin);
-        layout->addWidget(new QLabel("W:"));
-        layout->addWidget(widthSpin);
-        layout->addWidget(new QLabel("H:"));
-        layout->addWidget(heightSpin);
-
-        widget = container;
-    }
+    void addValues(RangeParam* param, RangeBound bound, const QVector<double>& values);
 
-    void apply() override {
-        *ptr = QRect(xSpin->value(), ySpin->value(), widthSpin->value(), heightSpin->value());
-    }
+    /**
+     * @brief Get the number of variants run() will write.
+     * @return The count, saturated at the largest qint64 for huge grids.
+     */
+    qint64 variantCount() const;
 
-    void reset() override {
-        xSpin->setValue(defVal.x());
-        ySpin->setValue(defVal.y());
-        widthSpin->setValue(defVal.width());
-        heightSpin->setValue(defVal.height());
-    }
+    /**
+     * @brief Write the base snapshot, all variants and the manifest.
+     * @param directory Output directory, created if needed.
+     * @param error Receives a description of the first failure (optional).
+     * @return Number of variant files written, or -1 on failure, in particular
+     *         if there are more than MaxVariants variants.
+     */
+    int run(const QString& directory, QString* error = nullptr);
 
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("x", QString::number(xSpin->value()));
-        w.writeAttribute("y", QString::number(ySpin->value()));
-        w.writeAttribute("width", QString::number(widthSpin->value()));
-        w.writeAttribute("height", QString::number(heightSpin->value()));
-        w.writeEndElement();
-    }
+private:
+    void addAxis(const QString& element, const QString& attribute, bool integer,
+        double widgetMin, double widgetMax, double from, double to, int levels, const QVector<double>& values);
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("x") && r.attributes().hasAttribute("y") &&
-            r.attributes().hasAttribute("width") && r.attributes().hasAttribute("height")) {
-            xSpin->setValue(r.attributes().value("x").toInt());
-            ySpin->setValue(r.attributes().value("y").toInt());
-            widthSpin->setValue(r.attributes().value("width").toInt());
-            heightSpin->setValue(r.attributes().value("height").toInt());
-        }
-        r.readNext();
-    }
-};
+    /**
+     * @brief Remember the current value of the other bound, which load() requires too.
+     */
+    void addRangeBound(RangeParam* param, RangeBound bound);
 
-/**
- * @class VariantParam
- * @brief Parameter class for handling QVariant values (fallback to string).
- */
-class VariantParam : public ParamBase {
-    Q_OBJECT
-    QVariant    * ptr; ///< Pointer to the variant value.
-    QVariant    defVal; ///< Default variant value.
-    QLineEdit   * edit; ///< Line edit for user input.
+    static qint64 gridLevels(const Axis& axis);
 
-public:
     /**
-     * @brief Constructor for VariantParam.
-     * @param name Parameter name.
-     * @param p Pointer to the variant value.
-     * @param def Default variant.
-     * @param tip Tooltip text.
-     * @param parent Parent widget (default: nullptr).
+     * @brief Map a position in [0, 1) to a value of an axis.
      */
-    VariantParam(QString name, QVariant* p, QVariant def, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = def;
-        edit = new QLineEdit(p->toString(), this);
-        edit->setToolTip(tip);
-        widget = edit;
-    }
+    static double valueAt(const Axis& axis, double u);
 
-    void apply() override { *ptr = edit->text(); }
-    void reset() override { edit->setText(defVal.toString()); }
-
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", edit->text());
-        w.writeEndElement();
-    }
+    /**
+     * @brief Uniform number in [0, 1) derived from the seed, variant and axis (SplitMix64).
+     */
+    double unit(int variant, int axis) const;
 
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            edit->setText(r.attributes().value("value").toString());
-        r.readNext();
-    }
-};
+    double sampleValue(int a, int variant, int total, const QVector<qint64>& strides,
+        const QVector<QVector<quint32>>& strata) const;
 
-/**
- * @class FloatParam
- * @brief Parameter class for handling single-precision floating-point values.
- */
-class FloatParam : public ParamBase {
-    Q_OBJECT
-        float* ptr; ///< Pointer to the float value.
-    float defVal; ///< Default value.
-    QDoubleSpinBox* spin; ///< Spin box for user input.
-public:
     /**
-     * @brief Constructor for FloatParam.
-     * @param name Parameter name.
-     * @param p Pointer to the float value.
-     * @param min Minimum allowed value.
-     * @param max Maximum allowed value.
-     * @param step Step size for the spin box.
-     * @param tip Tooltip text.
-     * @param parent Parent widget (default: nullptr).
+     * @brief Write one delta file: only the swept elements, referring to base.xml.
      */
-    FloatParam(QString name, float* p, float min, float max, float step, QString tip, QWidget* parent = nullptr)
-        : ParamBase(parent) {
-        this->name = name;
-        ptr = p;
-        defVal = *p;
-        spin = new QDoubleSpinBox(this);
-        spin->setRange(min, max);
-        spin->setSingleStep(step);
-        spin->setValue(*p);
-        spin->setToolTip(tip);
-        spin->setAlignment(Qt::AlignRight);
-        widget = spin;
-    }
-    void apply() override { *ptr = static_cast<float>(spin->value()); }
-    void reset() override { spin->setValue(defVal); }
-    void save(QXmlStreamWriter& w) const override {
-        w.writeStartElement(name);
-        w.writeAttribute("value", QString::number(spin->value(), 'f', 6));
-        w.writeEndElement();
-    }
-    void load(QXmlStreamReader& r) override {
-        if (r.attributes().hasAttribute("value"))
-            spin->setValue(r.attributes().value("value").toFloat());
-        r.readNext();
-    }
+    void writeVariant(QByteArray& buffer, int variant, const QVector<double>& sample) const;
 };
 
 /* -------------------------------------
-   Main Editor Dialog Class
+   QSettings Persistence Backend
    ------------------------------------- */
 
 /**
-* @class ParamsEditor
-* @brief Main parameter editor dialog container
-*
-* Features:
-* - Tab-based organization
-* - Apply/Cancel semantics
-* - XML import/export
-* - Integrated help system
-* - Automatic UI layout
-*
-* Usage workflow:
-* 1. Create ParamsEditor instance
-* 2. Add tabs with addTab()
-* 3. Add parameters to tabs with addParam()
-* 4. Optionally set help content
-* 5. Call show() to display
-*
-* Serialization example:
-* @code
-* // Save configuration
-* editor.saveToFile("settings.xml");
-*
-* // Load configuration
-* editor.loadFromFile("settings.xml");
-* @endcode
-*/
-
-class ParamsEditor : public QDialog {
+ * @class ParamsSettingsBackend
+ * @brief Persists the parameters of a ParamsEditor in a QSettings store.
+ *
+ * Each tab maps to a settings group and each parameter to a key in it. Keys are
+ * read lazily, when the row of a parameter is first shown or right before Apply.
+ * Parameters changed since the last write are tracked, and on Apply only those
+ * keys are written, followed by a single sync().
+ *
+ * Usage:
+ * @code
+ * ParamsEditor editor;
+ * // ... add tabs and parameters ...
+ * ParamsSettingsBackend backend(&editor, QDir::homePath() + "/.config/myapp.ini");
+ * editor.exec();
+ * @endcode
+ */
+class ParamsSettingsBackend : public QObject {
     Q_OBJECT
-    QTabWidget      * tabs; ///< Tab widget for organizing parameters.
-    QTextBrowser    * helpBrowser = nullptr; ///< Browser for displaying help text.
-    QVector<QVector<ParamBase*>> allParams; ///< List of parameters per tab.
-    QPushButton     * applyBtn; ///< Button to apply changes.
-    QPushButton     * cancelBtn; ///< Button to cancel changes.
-    bool helpTabCreated = false; ///< Flag if help tab was created.
+    ParamsEditor    * editor; ///< Editor whose parameters are persisted.
+    QSettings       * settings; ///< Settings store.
+    QHash<ParamBase*, QString> keys; ///< Settings key ("group/name") of each parameter.
+    QSet<ParamBase*> dirty; ///< Parameters changed since the last write.
+    QSet<ParamBase*> unread; ///< Parameters whose key has not been read yet.
+    bool            reading = false; ///< True while values read from the store are shown.
 
 public:
-    ParamsEditor(QWidget* parent = nullptr) : QDialog(parent) {
-        QVBoxLayout* mainLayout = new QVBoxLayout(this);
-        tabs = new QTabWidget(this);
-        mainLayout->addWidget(tabs);
-
-        QHBoxLayout* btnLayout = new QHBoxLayout;
-        applyBtn = new QPushButton("APPLY", this);
-        cancelBtn = new QPushButton("CANCEL", this);
-        btnLayout->addStretch();
-        btnLayout->addWidget(applyBtn);
-        btnLayout->addWidget(cancelBtn);
-        mainLayout->addLayout(btnLayout);
-
-        connect(applyBtn, &QPushButton::clicked, this, &ParamsEditor::onApplyClicked);
-        connect(cancelBtn, &QPushButton::clicked, this, &ParamsEditor::onCancelClicked);
-    }
-
     /**
-     * @brief Add a new tab to the editor.
-     * @param title Tab title.
-     * @param icon Tab icon (default: empty).
-     * @return Index of the new tab.
+     * @brief Constructor using an existing QSettings instance.
+     * @param editor Editor whose parameters are persisted.
+     * @param settings Settings store (not owned).
+     * @param parent Parent object (default: the editor).
      */
-    int addTab(const QString& title, const QIcon& icon = QIcon()) {
-        QWidget* page = new QWidget;
-        QVBoxLayout* layout = new QVBoxLayout(page);
-        layout->addStretch();
-        int index = tabs->count();
-        tabs->addTab(page, icon, title);
-        allParams.append(QVector<ParamBase*>()); // Initialize parameter vector for this tab
-        return index;
-    }
+    ParamsSettingsBackend(ParamsEditor* editor, QSettings* settings, QObject* parent = nullptr);
 
     /**
-     * @brief Add a parameter to a tab.
-     * @param tabIndex Index of the tab.
-     * @param param Pointer to the parameter object.
+     * @brief Constructor using an INI file.
+     * @param editor Editor whose parameters are persisted.
+     * @param iniFile Path of the INI file.
+     * @param parent Parent object (default: the editor).
      */
-    void addParam(int tabIndex, ParamBase* param) {
-        if (tabIndex < 0 || tabIndex >= allParams.size()) return;
-
-        QWidget* tabWidget = tabs->widget(tabIndex);
-        QVBoxLayout* layout = static_cast<QVBoxLayout*>(tabWidget->layout());
-        QHBoxLayout* row = new QHBoxLayout;
-        row->addStretch(); // Spinge tutto verso destra
-
-        QLabel* label = new QLabel(param->name);
-        label->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
-        label->setFixedWidth(120); // Larghezza fissa per allineare le etichette
-        row->addWidget(label);
-
-        // Imposta una larghezza fissa per il widget del parametro per uniformità
-        if (param->widget) {
-            param->widget->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
-            param->widget->setMinimumWidth(200); // Larghezza minima per i widget
-        }
-        row->addWidget(param->widget);
-
-        if (dynamic_cast<FilePathParam*>(param) || dynamic_cast<DirParam*>(param)) {
-            QPushButton* browseBtn = new QPushButton("BROWSE");
-            browseBtn->setFixedWidth(60);
-            browseBtn->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-            row->addWidget(browseBtn);
-            param->browseButton = browseBtn;
-            if (FilePathParam* fileParam = dynamic_cast<FilePathParam*>(param)) {
-                QObject::connect(browseBtn, &QPushButton::clicked, fileParam, &FilePathParam::onBrowseClicked);
-            }
-            else if (DirParam* dirParam = dynamic_cast<DirParam*>(param)) {
-                QObject::connect(browseBtn, &QPushButton::clicked, dirParam, &DirParam::onBrowseClicked);
-            }
-        }
-
-        QPushButton* defBtn = new QPushButton("DEF");
-        defBtn->setFixedWidth(40);
-        defBtn->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-        defBtn->setToolTip("Set default value");
-        row->addWidget(defBtn);
-        param->defButton = defBtn;
-        QObject::connect(defBtn, &QPushButton::clicked, [param]() { param->reset(); });
-
-        layout->insertLayout(layout->count() - 1, row);
-        allParams[tabIndex].append(param);
-    }
+    ParamsSettingsBackend(ParamsEditor* editor, const QString& iniFile, QObject* parent = nullptr);
 
     /**
-    * @brief Set the main help text for the Help tab.
-    * @param htmlText HTML-formatted help text.
-    */
-    void setMainHelp(const QString& htmlText) {
-        if (!helpTabCreated) {
-            helpBrowser = new QTextBrowser(this);
-            QWidget* helpTab = new QWidget;
-            QVBoxLayout* helpLayout = new QVBoxLayout(helpTab);
-            helpLayout->addWidget(helpBrowser);
-            tabs->addTab(helpTab, QIcon(), "Help");
-            helpTabCreated = true;
-        }
-        helpBrowser->setHtml(htmlText);
-    }
+     * @brief Get the settings store.
+     */
+    QSettings* store() const { return settings; }
 
     /**
-     * @brief Load parameters from an XML file.
-     * @param filename Path to the XML file.
+     * @brief Check whether a parameter has changes not yet written.
+     * @param param Parameter to check.
      */
-    void loadFromFile(const QString& filename) {
-        QFile file(filename);
-        if (!file.open(QIODevice::ReadOnly)) return;
-        QXmlStreamReader reader(&file);
-        while (!reader.atEnd()) {
-            reader.readNext();
-            if (reader.isStartElement()) {
-                for (auto& tab : allParams)
-                    for (auto* param : tab)
-                        if (param->name == reader.name())
-                            param->load(reader);
-            }
-        }
-    }
+    bool isDirty(ParamBase* param) const;
 
     /**
-     * @brief Save parameters to an XML file.
-     * @param filename Path to the XML file.
+     * @brief Read every key that has not been read yet.
      */
-    void saveToFile(const QString& filename) {
-        QFile file(filename);
-        if (!file.open(QIODevice::WriteOnly)) return;
-        QXmlStreamWriter writer(&file);
-        writer.setAutoFormatting(true);
-        writer.writeStartDocument();
-        writer.writeStartElement("Params");
-        for (const auto& tab : allParams)
-            for (const auto* param : tab)
-                param->save(writer);
-        writer.writeEndElement();
-        writer.writeEndDocument();
-    }
+    void readAll();
 
     /**
-     * @brief Show the dialog with a custom title and icon.
-     * @param windowTitle Title of the dialog (default: "Params Editor").
-     * @param icon Icon for the dialog (default: empty).
+     * @brief Read all keys again, discarding unsaved changes.
      */
-    void show(const QString& windowTitle = "Params Editor", const QIcon& icon = QIcon()) {
-        setWindowTitle(windowTitle);
-        setWindowIcon(icon);
-        if (tabs->count() > 1) {
-            tabs->setCurrentIndex(0);
-        }
-        QDialog::show();
-    }
+    void reload();
 
-private slots:
     /**
-     * @brief Handle the Apply button click.
+     * @brief Write the keys of all changed parameters, then sync once.
+     * @return True if the store was written without errors.
      */
-    void onApplyClicked() {
-        for (auto& tab : allParams)
-            for (auto* param : tab)
-                param->apply();
-        accept();
-    }
+    bool writeDirty();
+
+private:
+    void attach();
+
+    void track(int tab, ParamBase* param);
+
+    void read(ParamBase* param);
 
     /**
-     * @brief Handle the Cancel button click.
+     * @brief Make a tab title or parameter name usable as a single key level.
      */
-    void onCancelClicked() {
-        reject();
-    }
+    static QString keyName(QString name);
 };
 
    /* -------------------------------------
@@ -1403,16 +3506,20 @@ private slots:
     *
     * Automatically creates appropriate parameter types based on:
     * - QMetaType of properties
-    * - Supplemental metadata properties
+    * - Supplemental metadata
     *
-    * Supported metadata properties (for property "width"):
+    * Supported metadata keys (for property "width"):
     * - widthDisplay: Display name (QString)
     * - widthTooltip: Tooltip text (QString)
     * - widthCategory: Tab category (QString)
     * - widthMin: Minimum value (double/int)
     * - widthMax: Maximum value (double/int)
     * - widthStep: Value step (double/int)
-    * - widthEnumNames: Enum names (QStringList for enum properties)
+    *
+    * Enum properties take their options from the enumerator. Metadata is declared
+    * once per class, as Q_CLASSINFO entries or with registerMetadata(), and parsed
+    * the first time the class is bound. A property of the object with the same
+    * name (a Q_PROPERTY or a dynamic property) overrides it for that object.
     *
     * Usage:
     * @code
@@ -1422,18 +3529,14 @@ private slots:
     *     Q_PROPERTY(QString title MEMBER m_title)
     *
     *     // Metadata for 'threshold' property
-    *     Q_PROPERTY(int thresholdMin READ dummyConst STORED false)
-    *     Q_PROPERTY(int thresholdMax READ dummyConst STORED false)
-    *     Q_PROPERTY(QString thresholdTooltip READ dummyConst STORED false)
+    *     Q_CLASSINFO("thresholdMin", "0")
+    *     Q_CLASSINFO("thresholdMax", "100")
+    *     Q_CLASSINFO("thresholdTooltip", "Processing sensitivity")
     * public:
     *     AppConfig() :
     *         m_threshold(50),
     *         m_title("Default Title")
-    *     {
-    *         setProperty("thresholdMin", 0);
-    *         setProperty("thresholdMax", 100);
-    *         setProperty("thresholdTooltip", "Processing sensitivity");
-    *     }
+    *     {}
     * private:
     *     int m_threshold;
     *     QString m_title;
@@ -1442,6 +3545,7 @@ private slots:
     * // In application code:
     * AppConfig config;
     * ParamsEditor editor;
+    * config.setProperty("thresholdMax", 200); // Override for this object only
     * AdvancedPropertyAdapter::bindObjectToEditor(&editor, &config);
     * @endcode
     */
@@ -1470,77 +3574,41 @@ public:
         ParamsEditor* editor,
         QObject* obj,
         const QString& defaultTabName = "Properties"
-    ) {
-        const QMetaObject* meta = obj->metaObject();
-        QMap<QString, int> categoryToTabIndex;
-
-        // Create tabs based on categories
-        for (int i = 0; i < meta->propertyCount(); ++i) {
-            QMetaProperty prop = meta->property(i);
-            if (!prop.isWritable()) continue;
-
-            PropertyInfo info = extractPropertyInfo(obj, prop);
-            QString category = info.category.isEmpty() ? defaultTabName : info.category;
-
-            if (!categoryToTabIndex.contains(category)) {
-                int tabIndex = editor->addTab(category);
-                categoryToTabIndex[category] = tabIndex;
-            }
+    );
 
-            createParamForProperty(editor, categoryToTabIndex[category], obj, prop, info);
-        }
-
-        // Connessione per salvare i valori
-        QObject::connect(editor, &ParamsEditor::accepted, [obj]() {
-            qDebug() << "Properties updated";
-            });
-    }
+    /**
+     * @brief Register the metadata of a property for every object of a class.
+     *
+     * Replaces the Q_CLASSINFO metadata of that property; properties of the
+     * object still override it. Use from the GUI thread only.
+     * @param meta Class of the objects, e.g. &AppConfig::staticMetaObject.
+     * @param property Property name.
+     * @param info Metadata; an empty displayName keeps the default one.
+     */
+    static void registerMetadata(const QMetaObject* meta, const QString& property, const PropertyInfo& info);
 
 private:
-    static PropertyInfo extractPropertyInfo(QObject* obj, QMetaProperty prop) {
-        PropertyInfo info;
-        info.name = QString::fromUtf8(prop.name());
-
-        // Rimuovi il prefisso 'm_' per il nome visualizzato
-        QString cleanName = info.name;
-        if (cleanName.startsWith("m_")) {
-            cleanName = cleanName.mid(2);
-        }
-        cleanName.replace('_', ' ');
-
-        // Estrai metadati
-        QByteArray displayPropName = QByteArray(prop.name()) + "Display";
-        QVariant displayVar = obj->property(displayPropName);
-        info.displayName = displayVar.isValid() ? displayVar.toString() : cleanName;
-
-        QByteArray tooltipPropName = QByteArray(prop.name()) + "Tooltip";
-        QVariant tooltipVar = obj->property(tooltipPropName);
-        info.tooltip = tooltipVar.isValid() ? tooltipVar.toString() : "";
-
-        QByteArray categoryPropName = QByteArray(prop.name()) + "Category";
-        QVariant categoryVar = obj->property(categoryPropName);
-        info.category = categoryVar.isValid() ? categoryVar.toString() : "";
-
-        // Estrai range per valori numerici
-        QByteArray minPropName = QByteArray(prop.name()) + "Min";
-        info.min = obj->property(minPropName).toDouble();
+    /// Metadata of one class, parsed once.
+    struct ClassMetadata {
+        QHash<QString, PropertyInfo>    properties; ///< Static metadata by property name.
+        QSet<QByteArray>                declared; ///< Names of the properties declared by the class.
+    };
 
-        QByteArray maxPropName = QByteArray(prop.name()) + "Max";
-        info.max = obj->property(maxPropName).toDouble();
+    /**
+     * @brief Get the metadata of a class, parsing its Q_CLASSINFO entries and registrations on first use.
+     */
+    static const ClassMetadata& classMetadata(const QMetaObject* meta);
 
-        QByteArray stepPropName = QByteArray(prop.name()) + "Step";
-        info.step = obj->property(stepPropName).toDouble();
+    static QHash<const QMetaObject*, ClassMetadata>& metadataCache();
 
-        // Gestione enumerazioni
-        if (prop.isEnumType()) {
-            QMetaEnum e = prop.enumerator();
-            for (int j = 0; j < e.keyCount(); j++) {
-                info.enumNames << e.key(j);
-            }
-        }
+    static QHash<const QMetaObject*, QHash<QString, PropertyInfo>>& registry();
 
-        return info;
-    }
+    /**
+     * @brief Combine the class metadata of a property with the overrides set on the object.
+     * @param dynamicNames Names of the dynamic properties of the object.
+     */
+    static PropertyInfo extractPropertyInfo(QObject* obj, QMetaProperty prop,
+        const ClassMetadata& cls, const QSet<QByteArray>& dynamicNames);
 
     static void createParamForProperty(
         ParamsEditor* editor,
@@ -1548,55 +3616,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        int type = prop.userType();
-
-        if (type == QMetaType::Int) {
-            createIntParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::Double) {
-            createDoubleParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::Float) {
-            createFloatParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::Bool) {
-            createBoolParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QString) {
-            createStringParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QColor) {
-            createColorParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QStringList) {
-            createStringListParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QDate) {
-            createDateParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QTime) {
-            createTimeParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QPoint) {
-            createPointParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QSize) {
-            createSizeParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QRect) {
-            createRectParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (type == QMetaType::QVariant) {
-            createVariantParam(editor, tabIndex, obj, prop, info);
-        }
-        else if (prop.isEnumType()) {
-            createEnumParam(editor, tabIndex, obj, prop, info);
-        }
-        else {
-            qWarning() << "Unsupported type:" << prop.typeName() << "for property" << info.name;
-        }
-    }
+    );
 
     static void createIntParam(
         ParamsEditor* editor,
@@ -1604,21 +3624,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        int* valuePtr = new int(prop.read(obj).toInt());
-        int min = (info.min != 0 || info.max != 0) ? info.min : INT_MIN;
-        int max = (info.min != 0 || info.max != 0) ? info.max : INT_MAX;
-        int step = info.step != 0 ? info.step : 1;
-
-        IntParam* param = new IntParam(
-            info.displayName,
-            valuePtr,
-            min, max, step,
-            info.tooltip
-        );
-
-        setupParamConnections<IntParam, int>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createDoubleParam(
         ParamsEditor* editor,
@@ -1626,21 +3632,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        double* valuePtr = new double(prop.read(obj).toDouble());
-        double min = (info.min != 0 || info.max != 0) ? info.min : -DBL_MAX;
-        double max = (info.min != 0 || info.max != 0) ? info.max : DBL_MAX;
-        double step = info.step != 0 ? info.step : 0.1;
-
-        DoubleParam* param = new DoubleParam(
-            info.displayName,
-            valuePtr,
-            min, max, step,
-            info.tooltip
-        );
-
-        setupParamConnections<DoubleParam, double>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createFloatParam(
         ParamsEditor* editor,
@@ -1648,21 +3640,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        float* valuePtr = new float(prop.read(obj).toFloat());
-        float min = (info.min != 0 || info.max != 0) ? static_cast<float>(info.min) : -FLT_MAX;
-        float max = (info.min != 0 || info.max != 0) ? static_cast<float>(info.max) : FLT_MAX;
-        float step = info.step != 0 ? static_cast<float>(info.step) : 0.1f;
-
-        FloatParam* param = new FloatParam(
-            info.displayName,
-            valuePtr,
-            min, max, step,
-            info.tooltip
-        );
-
-        setupParamConnections<FloatParam, float>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createBoolParam(
         ParamsEditor* editor,
@@ -1670,19 +3648,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        bool* valuePtr = new bool(prop.read(obj).toBool());
-        bool defVal = *valuePtr;
-
-        BoolParam* param = new BoolParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<BoolParam, bool>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createStringParam(
         ParamsEditor* editor,
@@ -1690,20 +3656,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QString* valuePtr = new QString(prop.read(obj).toString());
-        QString defVal = *valuePtr;
-
-        StringParam* param = new StringParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            Qt::ImhNone,
-            info.tooltip
-        );
-
-        setupParamConnections<StringParam, QString>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createColorParam(
         ParamsEditor* editor,
@@ -1711,19 +3664,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QColor* valuePtr = new QColor(prop.read(obj).value<QColor>());
-        QColor defVal = *valuePtr;
-
-        ColorParam* param = new ColorParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<ColorParam, QColor>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createStringListParam(
         ParamsEditor* editor,
@@ -1731,19 +3672,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QStringList* valuePtr = new QStringList(prop.read(obj).toStringList());
-        QStringList defVal = *valuePtr;
-
-        StringListParam* param = new StringListParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<StringListParam, QStringList>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createDateParam(
         ParamsEditor* editor,
@@ -1751,19 +3680,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QDate* valuePtr = new QDate(prop.read(obj).toDate());
-        QDate defVal = *valuePtr;
-
-        DateParam* param = new DateParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<DateParam, QDate>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createTimeParam(
         ParamsEditor* editor,
@@ -1771,19 +3688,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QTime* valuePtr = new QTime(prop.read(obj).toTime());
-        QTime defVal = *valuePtr;
-
-        TimeParam* param = new TimeParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<TimeParam, QTime>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createPointParam(
         ParamsEditor* editor,
@@ -1791,19 +3696,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QPoint* valuePtr = new QPoint(prop.read(obj).toPoint());
-        QPoint defVal = *valuePtr;
-
-        PointParam* param = new PointParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<PointParam, QPoint>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createSizeParam(
         ParamsEditor* editor,
@@ -1811,19 +3704,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QSize* valuePtr = new QSize(prop.read(obj).toSize());
-        QSize defVal = *valuePtr;
-
-        SizeParam* param = new SizeParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<SizeParam, QSize>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createRectParam(
         ParamsEditor* editor,
@@ -1831,19 +3712,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QRect* valuePtr = new QRect(prop.read(obj).toRect());
-        QRect defVal = *valuePtr;
-
-        RectParam* param = new RectParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<RectParam, QRect>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createVariantParam(
         ParamsEditor* editor,
@@ -1851,19 +3720,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        QVariant* valuePtr = new QVariant(prop.read(obj));
-        QVariant defVal = *valuePtr;
-
-        VariantParam* param = new VariantParam(
-            info.displayName,
-            valuePtr,
-            defVal,
-            info.tooltip
-        );
-
-        setupParamConnections<VariantParam, QVariant>(editor, tabIndex, param, obj, prop, valuePtr);
-    }
+    );
 
     static void createEnumParam(
         ParamsEditor* editor,
@@ -1871,33 +3728,7 @@ private:
         QObject* obj,
         QMetaProperty prop,
         const PropertyInfo& info
-    ) {
-        int* valuePtr = new int(prop.read(obj).toInt());
-        QStringList* options = new QStringList(info.enumNames);
-        int defIndex = *valuePtr;
-
-        ComboParam* param = new ComboParam(
-            info.displayName,
-            options,
-            valuePtr,
-            defIndex,
-            info.tooltip
-        );
-
-        QObject::connect(param, &ComboParam::destroyed, [valuePtr, options]() {
-            delete valuePtr;
-            delete options;
-            });
-
-        QComboBox* combo = static_cast<QComboBox*>(param->widget);
-        QObject::connect(combo, QOverload<int>::of(&QComboBox::currentIndexChanged),
-            [obj, prop, valuePtr](int index) {
-                *valuePtr = index;
-                prop.write(obj, *valuePtr);
-            });
-
-        editor->addParam(tabIndex, param);
-    }
+    );
 
     template<typename ParamType, typename ValueType>
     static void setupParamConnections(
@@ -1912,7 +3743,7 @@ private:
             delete valuePtr;
             });
 
-        QObject::connect(editor, &ParamsEditor::accepted, [obj, prop, valuePtr]() {
+        QObject::connect(param, &ParamBase::applied, obj, [obj, prop, valuePtr]() {
             prop.write(obj, *valuePtr);
             });
 
@@ -0,0 +1,718 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file parameditor_p.h
+ * @brief Implementation classes of the parameter editor.
+ *
+ * Models, delegates, caches, queues and worker threads used only by
+ * parameditor.cpp. parameditor.h holds them through pointers and forward
+ * declarations, so code including the public header never parses them or the
+ * Qt headers they need. Not part of the public API: include it only from
+ * parameditor.cpp.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ */
+
+#ifndef PARAMEDITOR_P_H
+#define PARAMEDITOR_P_H
+
+#include "parameditor.h"
+#include <QAbstractItemModel>
+#include <QAbstractScrollArea>
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QSemaphore>
+#include <QStyledItemDelegate>
+#include <QThread>
+#include <QThreadPool>
+#include <QUndoCommand>
+#include <vector>
+
+/* -------------------------------------
+   Thumbnail Cache
+   ------------------------------------- */
+
+/**
+ * @class ThumbnailCache
+ * @brief Process-wide LRU cache of image thumbnails decoded on worker threads.
+ *
+ * Entries are keyed by file path, modification time and thumbnail size, so an
+ * image that changes on disk is decoded again while unchanged files are served
+ * from memory. Files are stat'ed and decoded on a private QThreadPool with
+ * QImageReader::setScaledSize, so full-size images are never decoded and the GUI
+ * thread never touches the file system. The cache is shared by all editors and
+ * is destroyed, its workers finished, when the application is about to quit.
+ */
+class ThumbnailCache : public QObject {
+    Q_OBJECT
+
+    /// Callback of a request waiting for its thumbnail.
+    struct Waiter {
+        QPointer<QObject>                   receiver; ///< Object the callback belongs to.
+        std::function<void(const QImage&)>  ready; ///< Called with the decoded thumbnail.
+    };
+
+    QCache<QString, QImage> cache; ///< Decoded thumbnails, cost in KiB (LRU eviction).
+    QHash<QString, QString> latestKey; ///< Last known cache key for each path and size, pruned of evicted keys.
+    QSet<QString>           pending; ///< Paths and sizes currently queued for decoding.
+    QHash<QString, QVector<Waiter>> waiting; ///< Callbacks of the pending requests.
+    QThreadPool             pool; ///< Worker threads used for stat and decode.
+
+    ThumbnailCache();
+
+public:
+    /**
+     * @brief Access the process-wide cache instance, created on first use.
+     * @return The cache, or nullptr once the application is about to quit.
+     */
+    static ThumbnailCache* instance();
+
+    ~ThumbnailCache();
+
+    /**
+     * @brief Set the maximum amount of memory used by cached thumbnails.
+     * @param kib Budget in KiB.
+     */
+    void setMaxCost(int kib);
+
+    /**
+     * @brief Get a thumbnail, scheduling an asynchronous decode or revalidation.
+     *
+     * Returns the cached image immediately when one is known for the path (it may
+     * be refreshed later). Otherwise returns a null image, and once the worker
+     * has decoded the file, ready is called and thumbnailReady() is emitted.
+     * @param path Image file path.
+     * @param size Bounding size of the thumbnail.
+     * @param receiver Object owning the callback; a later request of the same
+     *        receiver for the same path and size replaces it, and it is dropped
+     *        if the receiver is destroyed first.
+     * @param ready Called on the GUI thread with the decoded thumbnail.
+     * @return The cached thumbnail or a null QImage.
+     */
+    QImage request(const QString& path, const QSize& size, QObject* receiver = nullptr,
+        const std::function<void(const QImage&)>& ready = nullptr);
+
+signals:
+    /**
+     * @brief Emitted on the GUI thread when a thumbnail has been decoded.
+     * @param path Image file path.
+     * @param image Decoded thumbnail (null if the file could not be read).
+     */
+    void thumbnailReady(const QString& path, const QImage& image);
+
+private:
+    /**
+     * @brief Queue a stat and, unless the file still has knownKey, a decode.
+     */
+    void schedule(const QString& request, const QString& path, const QSize& size, const QString& knownKey);
+
+    void onDecoded(const QString& request, const QString& path, const QString& key, const QImage& image);
+
+    /**
+     * @brief Revalidation found the file unchanged: serve the waiters from memory, or decode again if evicted.
+     */
+    void onUnchanged(const QString& request, const QString& path, const QSize& size);
+
+    /**
+     * @brief Call and forget the callbacks waiting for a request.
+     */
+    void deliver(const QString& request, const QImage& image);
+};
+
+/* -------------------------------------
+   Record Table Model
+   ------------------------------------- */
+
+/**
+ * @class RecordTableModel
+ * @brief Table model over row-major cells in one contiguous vector.
+ *
+ * The model holds no per-row or per-cell objects besides the QVariant cells
+ * themselves, so a table of 100k rows costs the cells and nothing else.
+ */
+class RecordTableModel : public QAbstractTableModel {
+    Q_OBJECT
+    QVector<RecordColumn>   columns; ///< Column definitions.
+    QVector<QVariant>       cells; ///< Row-major cells, rowCount() * columns.size() of them.
+
+public:
+    /**
+     * @brief Constructor for RecordTableModel.
+     * @param c Column definitions.
+     * @param parent Parent object (default: nullptr).
+     */
+    RecordTableModel(const QVector<RecordColumn>& c, QObject* parent = nullptr);
+
+    /**
+     * @brief Get the row-major cells.
+     */
+    const QVector<QVariant>& values() const { return cells; }
+
+    /**
+     * @brief Replace all cells, emitting edited() if any of them changes.
+     * @param values Row-major cells; each is coerced to its column and a partial last row is dropped.
+     */
+    void setValues(const QVector<QVariant>& values);
+
+    /**
+     * @brief Get a column definition.
+     */
+    const RecordColumn& column(int c) const { return columns.at(c); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    bool insertRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    bool moveRows(const QModelIndex& sourceParent, int sourceRow, int count,
+        const QModelIndex& destinationParent, int destinationChild) override;
+
+signals:
+    /**
+     * @brief Emitted when cells are edited, inserted, removed, moved or replaced.
+     */
+    void edited();
+};
+
+/**
+ * @class RecordColumnDelegate
+ * @brief Item delegate editing the cells of one RecordTableParam column.
+ *
+ * Int and Double cells get a compact spin box with the column range, Choice
+ * cells a combo box of the options, String cells a line edit; Bool cells are
+ * check boxes toggled without an editor.
+ */
+class RecordColumnDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+    RecordColumn    column; ///< Column edited by the delegate.
+
+public:
+    /**
+     * @brief Constructor for RecordColumnDelegate.
+     * @param c Column definition.
+     * @param parent Parent object (default: nullptr).
+     */
+    RecordColumnDelegate(const RecordColumn& c, QObject* parent = nullptr);
+
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+};
+
+/* -------------------------------------
+   Variant Tree Model
+   ------------------------------------- */
+
+/**
+ * @class VariantTreeModel
+ * @brief Tree model over a nested QVariantMap / QVariantHash / QVariantList, built on demand.
+ *
+ * A node holds its QVariant, which shares the data of the original container,
+ * and creates its children only when fetchMore() is called for it, i.e. when the
+ * node is first expanded. Setting a root of any size therefore costs one node.
+ * rootValue() rebuilds only the containers that were expanded; the others are
+ * returned as they were, still sharing the original data.
+ *
+ * Columns: key (or list index), value, type name. Only leaves are editable, and
+ * an edited value is converted back to the type of the leaf.
+ */
+class VariantTreeModel : public QAbstractItemModel {
+    Q_OBJECT
+
+    /// One key or list entry.
+    struct Node {
+        Node        * parent = nullptr; ///< Parent node, nullptr for the invisible top node.
+        int         row = 0; ///< Index among the parent's children.
+        QString     key; ///< Map key, empty for list entries.
+        QVariant    value; ///< Leaf value, or the container as it was before it was expanded.
+        bool        fetched = false; ///< True once the children were created.
+        std::vector<std::unique_ptr<Node>> children; ///< Children, empty until fetched.
+    };
+
+    Node    top; ///< Invisible node whose only child is the root value.
+
+public:
+    /**
+     * @brief Constructor for VariantTreeModel.
+     * @param parent Parent object (default: nullptr).
+     */
+    explicit VariantTreeModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Replace the tree, emitting edited() if the value differs.
+     * @param v Root value, shown as the only top-level row.
+     */
+    void setRoot(const QVariant& v);
+
+    /**
+     * @brief Get the root value, with the edits applied.
+     */
+    QVariant rootValue() const;
+
+    /**
+     * @brief Check whether a value is shown as an expandable node.
+     */
+    static bool isContainer(const QVariant& v);
+
+    /**
+     * @brief Get the text shown for a leaf value.
+     */
+    static QString leafText(const QVariant& v);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+signals:
+    /**
+     * @brief Emitted when a leaf is edited or the tree is replaced by another value.
+     */
+    void edited();
+
+private:
+    const Node* nodeOf(const QModelIndex& index) const;
+
+    Node* nodeOf(const QModelIndex& index);
+
+    static QVariant rebuild(const Node* node);
+};
+
+/**
+ * @class VariantTreeDelegate
+ * @brief Item delegate giving each leaf of a VariantTreeModel an editor for its type.
+ *
+ * Int leaves get a compact spin box, the other integer and floating-point types
+ * a line edit accepting only numbers of that type, so no precision is lost to
+ * a spin box's decimals. Strings, dates and times use the default editors, and
+ * booleans are check boxes.
+ */
+class VariantTreeDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    QWidget* createEditor(QWidget* parent, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    void setEditorData(QWidget* editor, const QModelIndex& index) const override;
+    void setModelData(QWidget* editor, QAbstractItemModel* model, const QModelIndex& index) const override;
+};
+
+/* -------------------------------------
+   Scrollable Tab Page
+   ------------------------------------- */
+
+/**
+ * @class ParamPage
+ * @brief Scrollable tab page that only lays out the rows inside the viewport.
+ *
+ * Every ParamBase is used as its own row widget. Its label, editor and buttons
+ * are arranged the first time the row scrolls into view; rows outside the
+ * viewport are hidden, so they take no part in layout or painting. Row offsets
+ * are kept as prefix sums, which makes finding the visible range a binary search
+ * regardless of the number of rows.
+ */
+class ParamPage : public QAbstractScrollArea {
+    Q_OBJECT
+    QVector<ParamBase*> rows; ///< Parameters in display order.
+    QVector<int>    rowTop; ///< Top offset of each row, plus the total height as last item.
+    int             rowHeight; ///< Standard row height.
+    int             firstVisible = 0; ///< First row currently shown.
+    int             lastVisible = 0; ///< One past the last row currently shown.
+    int             contentWidth = 0; ///< Widest realized row, used for the size hint.
+    bool            relayoutPending = false; ///< True if a deferred relayout is queued.
+    QSet<ParamBase*> selection; ///< Rows selected by clicking their labels.
+    int             anchor = -1; ///< Row where the last click selection started.
+
+public:
+    ParamPage(QWidget* parent = nullptr);
+
+    /**
+     * @brief Height of a row holding a standard single-line editor.
+     */
+    static int standardRowHeight();
+
+    /**
+     * @brief Append a parameter row to the page.
+     * @param param Parameter to show; the page takes ownership.
+     */
+    void addRow(ParamBase* param);
+
+    /**
+     * @brief Scroll the page so that a parameter row is visible.
+     * @param param Parameter to reveal.
+     */
+    void ensureVisible(ParamBase* param);
+
+    /**
+     * @brief Get the selected parameters in display order.
+     */
+    QVector<ParamBase*> selectedParams() const;
+
+    /**
+     * @brief Deselect all rows.
+     */
+    void clearSelection();
+
+    bool eventFilter(QObject* o, QEvent* e) override;
+
+    QSize sizeHint() const override;
+
+signals:
+    /**
+     * @brief Emitted when the row selection changes.
+     */
+    void selectionChanged();
+
+    /**
+     * @brief Emitted when a context menu is requested on the page.
+     * @param globalPos Position of the request in global coordinates.
+     */
+    void contextMenuRequested(const QPoint& globalPos);
+
+    /**
+     * @brief Emitted after the row of a parameter has been laid out for the first time.
+     * @param param Parameter whose row was realized.
+     */
+    void rowRealized(ParamBase* param);
+
+protected:
+    void scrollContentsBy(int, int) override;
+
+    void contextMenuEvent(QContextMenuEvent* e) override;
+
+    void resizeEvent(QResizeEvent* e) override;
+
+    void showEvent(QShowEvent* e) override;
+
+private:
+    void updateScrollRange();
+
+    void scheduleRelayout();
+
+    /**
+     * @brief Show and position the rows inside the viewport, hiding all others.
+     */
+    void relayout();
+
+    /**
+     * @brief Update the selection after a click on a row label.
+     * @param index Clicked row.
+     * @param modifiers Ctrl toggles the row, Shift extends from the anchor.
+     */
+    void selectRow(int index, Qt::KeyboardModifiers modifiers);
+
+    /**
+     * @brief Show the selection state of a row on its label.
+     */
+    static void highlight(ParamBase* param, bool on);
+
+    /**
+     * @brief Build the label, editor and buttons of a row the first time it is shown.
+     * @param param Parameter whose row is realized.
+     */
+    void realizeRow(ParamBase* param);
+};
+
+/**
+ * @class ParamValuesCommand
+ * @brief Undoable command that sets the values of several parameters at once.
+ *
+ * Widget updates are suspended on the given view while values are assigned,
+ * so a batch of thousands of values triggers a single repaint.
+ */
+class ParamValuesCommand : public QUndoCommand {
+    QPointer<QWidget>   view; ///< Widget whose updates are suspended during assignment.
+    QVector<ParamBase*> params; ///< Target parameters.
+    QVariantList        oldValues; ///< Values before the command.
+    QVariantList        newValues; ///< Values after the command.
+    bool                skipRedo; ///< True if the new values are already shown.
+
+public:
+    /**
+     * @brief Constructor for ParamValuesCommand.
+     * @param text Text shown in undo/redo actions.
+     * @param view Widget whose updates are suspended during assignment.
+     * @param params Target parameters.
+     * @param oldValues Values before the command, one per parameter.
+     * @param newValues Values after the command, one per parameter.
+     * @param applied True if the widgets already show the new values.
+     */
+    ParamValuesCommand(const QString& text, QWidget* view, const QVector<ParamBase*>& params,
+        const QVariantList& oldValues, const QVariantList& newValues, bool applied = false);
+
+    void undo() override;
+    void redo() override;
+
+private:
+    void assign(const QVariantList& values);
+};
+
+/* -------------------------------------
+   Lock-free Queue and Audit Log Writer
+   ------------------------------------- */
+
+/**
+ * @class LockFreeQueue
+ * @brief Bounded multi-producer multi-consumer lock-free queue.
+ *
+ * Array-based queue where each cell carries a sequence number (D. Vyukov's
+ * design): producers and consumers claim cells with a single CAS and never wait
+ * for each other. The capacity is rounded up to a power of two and all cells are
+ * allocated up front, so pushing never allocates.
+ * @tparam T Element type; must be default constructible and movable.
+ */
+template<typename T>
+class LockFreeQueue {
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> cells; ///< Ring of cells.
+    size_t mask; ///< Capacity minus one.
+    std::atomic<size_t> enqueuePos{ 0 }; ///< Next cell to write.
+    char padding[64]; ///< Keeps producer and consumer positions on separate cache lines.
+    std::atomic<size_t> dequeuePos{ 0 }; ///< Next cell to read.
+
+public:
+    /**
+     * @brief Constructor for LockFreeQueue.
+     * @param capacity Minimum number of elements the queue can hold.
+     */
+    explicit LockFreeQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /**
+     * @brief Get the number of elements the queue can hold.
+     */
+    size_t capacity() const { return mask + 1; }
+
+    /**
+     * @brief Append an element without blocking.
+     * @param value Element to append.
+     * @return False if the queue is full.
+     */
+    bool tryPush(T value) {
+        Cell* cell;
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element without blocking.
+     * @param value Receives the element.
+     * @return False if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        Cell* cell;
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(seq) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->data);
+        cell->data = T(); // Release shared data here rather than in a producer
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/**
+ * @class ParamAuditWriter
+ * @brief Queue and writer thread behind a ParamAuditLog.
+ *
+ * Records are pushed into a LockFreeQueue by any thread; run() drains it in
+ * batches, formats the lines and writes, rotates and retries the file as
+ * described for ParamAuditLog.
+ */
+class ParamAuditWriter : public QThread {
+    Q_OBJECT
+public:
+    /// One applied change.
+    struct Record {
+        qint64      timestamp = 0; ///< Milliseconds since the epoch (UTC).
+        QString     user; ///< User who applied the change.
+        QString     name; ///< Parameter name, prefixed with its tab.
+        QVariant    oldValue; ///< Value before Apply.
+        QVariant    newValue; ///< Value after Apply.
+    };
+
+private:
+    LockFreeQueue<Record> queue; ///< Records waiting to be written.
+    QString         path; ///< Path of the current log file.
+    qint64          maxBytes; ///< Size at which the file is rotated.
+    int             maxFiles; ///< Number of rotated files kept.
+    std::atomic<bool> stopping{ false }; ///< Set to stop the writer thread.
+    std::atomic<quint64> dropped{ 0 }; ///< Records lost because the queue was full.
+    std::atomic<quint64> lost{ 0 }; ///< Records lost because the file could not be written.
+    QSemaphore      wake; ///< Released by push() and stop() to wake the writer.
+
+public:
+    /**
+     * @brief Constructor for ParamAuditWriter.
+     * @param path Path of the log file.
+     * @param maxBytes File size that triggers a rotation.
+     * @param maxFiles Number of rotated files kept.
+     * @param capacity Number of records that can be queued.
+     */
+    ParamAuditWriter(const QString& path, qint64 maxBytes, int maxFiles, size_t capacity);
+
+    /**
+     * @brief Queue a record and wake the writer. Never blocks.
+     * @return False if the queue was full and the record was dropped.
+     */
+    bool push(Record r);
+
+    /**
+     * @brief Write the pending records and stop the thread.
+     */
+    void stop();
+
+    quint64 droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    quint64 lostCount() const { return lost.load(std::memory_order_relaxed); }
+
+signals:
+    /**
+     * @brief Emitted by the writer thread once per distinct failure.
+     * @param reason File and cause.
+     */
+    void writeFailed(const QString& reason);
+
+protected:
+    void run() override;
+
+private:
+    static QByteArray formatLine(const Record& r);
+
+    /**
+     * @brief Write a batch, rotating the file first if it would exceed the size limit.
+     * @param file Log file, opened here if it is not open.
+     * @param batch Lines to write; the written part is removed.
+     * @param error Set to the cause of a failure, rotation included.
+     * @return True if the whole batch was written.
+     */
+    bool writeBatch(QFile& file, QByteArray& batch, QString* error);
+
+    /**
+     * @brief Close the file and shift the rotated files.
+     * @return False if the file could not be renamed; it is then written on.
+     */
+    bool rotate(QFile& file);
+};
+
+/* -------------------------------------
+   Monitor Sparkline
+   ------------------------------------- */
+
+/**
+ * @class Sparkline
+ * @brief Small plot of the recent history of a monitored value.
+ *
+ * The history is a fixed-size ring of per-frame minimum and maximum, drawn as a
+ * band (a line where they coincide) scaled to the range of the visible history.
+ * All storage, the drawn outline included, is allocated by the constructor.
+ */
+class Sparkline : public QWidget {
+    Q_OBJECT
+    QVector<float>      lows; ///< Ring of per-frame minimum values.
+    QVector<float>      highs; ///< Ring of per-frame maximum values.
+    QVector<QPointF>    outline; ///< Reused outline of the band, two points per frame.
+    int                 next = 0; ///< Ring slot of the next frame.
+    int                 count = 0; ///< Number of frames held.
+
+public:
+    /**
+     * @brief Constructor for Sparkline.
+     * @param length Number of frames kept.
+     * @param parent Parent widget (default: nullptr).
+     */
+    explicit Sparkline(int length, QWidget* parent = nullptr);
+
+    /**
+     * @brief Append the range of one frame, dropping the oldest if the history is full.
+     * @param low Lowest value of the frame.
+     * @param high Highest value of the frame.
+     */
+    void append(float low, float high);
+
+    /**
+     * @brief Forget the history.
+     */
+    void clear();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* e) override;
+};
+
+#endif // PARAMEDITOR_P_H
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file paramquick.cpp
+ * @brief Implementation of the Qt Quick front end declared in paramquick.h.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ */
+
+#include "paramquick.h"
+#include <QtQml>
+#include <QtQuick>
+
+ParamListModel::ParamListModel(ParamsEditor* e, QObject* parent)
+    : QAbstractListModel(parent), editor(e) {
+    for (int tab = 0; tab < editor->tabCount(); ++tab)
+        for (ParamBase* param : editor->params(tab))
+            track(rows.size(), tab, param);
+    connect(editor, &ParamsEditor::paramAdded, this, &ParamListModel::onParamAdded);
+}
+
+int ParamListModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant ParamListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rows.size()) return QVariant();
+    const Row& row = rows[index.row()];
+    ParamBase* param = row.param;
+    switch (role) {
+    case Qt::DisplayRole:
+    case NameRole: return param->name;
+    case TypeRole: return row.type;
+    case ValueRole: return param->value();
+    case TextRole: return textOf(param->value());
+    case MinimumRole: return bound(param, false);
+    case MaximumRole: return bound(param, true);
+    case OptionsRole:
+        if (ComboParam* combo = dynamic_cast<ComboParam*>(param)) return combo->items();
+        return QVariant();
+    case UnitRole:
+        return param->unitDimension().isEmpty() ? QString()
+            : ParamUnits::instance().units(param->unitDimension()).value(0);
+    case Qt::ToolTipRole:
+    case TipRole: return param->widget ? param->widget->toolTip() : QString();
+    case TabRole: return editor->tabTitle(row.tab);
+    case ValidRole: return param->isValid();
+    default: return QVariant();
+    }
+}
+
+bool ParamListModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (!index.isValid() || index.row() >= rows.size() || (role != ValueRole && role != Qt::EditRole))
+        return false;
+    QVariant v = value;
+    if (v.userType() == qMetaTypeId<QJSValue>())
+        v = v.value<QJSValue>().toVariant();
+    if (rows[index.row()].type == QLatin1String("color") && v.type() == QVariant::String)
+        v = QColor(v.toString());
+    rows[index.row()].param->setValue(v);
+    return true;
+}
+
+Qt::ItemFlags ParamListModel::flags(const QModelIndex& index) const {
+    return QAbstractListModel::flags(index) | Qt::ItemIsEditable;
+}
+
+QHash<int, QByteArray> ParamListModel::roleNames() const {
+    return {
+        { NameRole, "name" }, { TypeRole, "type" }, { ValueRole, "value" }, { TextRole, "text" },
+        { MinimumRole, "minimum" }, { MaximumRole, "maximum" }, { OptionsRole, "options" },
+        { UnitRole, "unit" }, { TipRole, "tip" }, { TabRole, "tab" }, { ValidRole, "valid" }
+    };
+}
+
+bool ParamListModel::apply() { return editor->applyAll(); }
+
+void ParamListModel::reset(int row) {
+    if (row >= 0 && row < rows.size())
+        rows[row].param->reset();
+}
+
+void ParamListModel::load(const QString& path) { editor->loadFromFile(localPath(path)); }
+
+void ParamListModel::save(const QString& path) { editor->saveToFile(localPath(path)); }
+
+QString ParamListModel::typeOf(ParamBase* param) {
+    if (dynamic_cast<BoolParam*>(param)) return "bool";
+    if (dynamic_cast<IntParam*>(param)) return "int";
+    if (dynamic_cast<DoubleParam*>(param) || dynamic_cast<FloatParam*>(param) || dynamic_cast<SliderParam*>(param))
+        return "double";
+    if (dynamic_cast<ComboParam*>(param)) return "choice";
+    if (dynamic_cast<ColorParam*>(param)) return "color";
+    if (dynamic_cast<RangeParam*>(param)) return "range";
+    if (dynamic_cast<PasswordParam*>(param)) return "password";
+    if (dynamic_cast<StringParam*>(param) || dynamic_cast<FilePathParam*>(param)
+        || dynamic_cast<DirParam*>(param) || dynamic_cast<ImageParam*>(param))
+        return "text";
+    return "other";
+}
+
+void ParamListModel::onParamAdded(int tab, ParamBase* param) {
+    int position = 0;
+    while (position < rows.size() && rows[position].tab <= tab)
+        ++position;
+    beginInsertRows(QModelIndex(), position, position);
+    track(position, tab, param);
+    endInsertRows();
+}
+
+void ParamListModel::track(int position, int tab, ParamBase* param) {
+    rows.insert(position, Row{ param, tab, typeOf(param) });
+    connect(param, &ParamBase::changed, this, [this, param]() { rowChanged(param, { ValueRole, TextRole }); });
+    connect(param, &ParamBase::validityChanged, this, [this, param]() { rowChanged(param, { ValidRole }); });
+    connect(param, &QObject::destroyed, this, [this, param]() {
+        const int row = rowOf(param);
+        if (row < 0) return;
+        beginRemoveRows(QModelIndex(), row, row);
+        rows.remove(row);
+        endRemoveRows();
+        });
+}
+
+int ParamListModel::rowOf(const ParamBase* param) const {
+    for (int i = 0; i < rows.size(); ++i)
+        if (rows[i].param == param)
+            return i;
+    return -1;
+}
+
+void ParamListModel::rowChanged(const ParamBase* param, const QVector<int>& roles) {
+    const int row = rowOf(param);
+    if (row >= 0)
+        emit dataChanged(index(row), index(row), roles);
+}
+
+QVariant ParamListModel::bound(ParamBase* param, bool upper) {
+    if (IntParam* p = dynamic_cast<IntParam*>(param)) return upper ? p->maximum() : p->minimum();
+    if (DoubleParam* p = dynamic_cast<DoubleParam*>(param)) return upper ? p->maximum() : p->minimum();
+    if (FloatParam* p = dynamic_cast<FloatParam*>(param)) return upper ? p->maximum() : p->minimum();
+    if (SliderParam* p = dynamic_cast<SliderParam*>(param)) return upper ? p->maximum() : p->minimum();
+    if (RangeParam* p = dynamic_cast<RangeParam*>(param)) return upper ? p->maximum() : p->minimum();
+    return QVariant();
+}
+
+QString ParamListModel::textOf(const QVariant& v) {
+    switch (v.userType()) {
+    case QMetaType::Double: return QString::number(v.toDouble(), 'g', 8);
+    case QMetaType::QColor: return v.value<QColor>().name();
+    case QMetaType::QVariantList: {
+        QStringList parts;
+        for (const QVariant& item : v.toList())
+            parts << textOf(item);
+        return parts.join(", ");
+    }
+    default: return v.toString();
+    }
+}
+
+QString ParamListModel::localPath(const QString& path) {
+    const QUrl url(path);
+    return url.isLocalFile() ? url.toLocalFile() : path;
+}
+
+ParamQuickView::ParamQuickView(ParamsEditor* editor, QWindow* parent)
+    : QQuickView(parent) {
+    model = new ParamListModel(editor, this);
+    rootContext()->setContextProperty("paramModel", model);
+    setResizeMode(QQuickView::SizeRootObjectToView);
+    QQmlComponent* component = new QQmlComponent(engine(), this);
+    component->setData(qml(), QUrl());
+    if (component->isError())
+        qWarning() << component->errors();
+    setContent(QUrl(), component, component->create(rootContext()));
+}
+
+void ParamQuickView::useSoftwareRenderer() {
+    QQuickWindow::setSceneGraphBackend(QSGRendererInterface::Software);
+}
+
+QByteArray ParamQuickView::qml() {
+    return R"QML(
+import QtQuick 2.15
+import QtQuick.Controls 2.15
+import QtQuick.Layouts 1.15
+import Qt.labs.qmlmodels 1.0
+
+Page {
+    id: root
+
+    component ParamRow: RowLayout {
+        property string title
+        width: ListView.view ? ListView.view.width : 0
+        height: 44
+        spacing: 8
+        Label {
+            text: title
+            Layout.preferredWidth: 140
+            Layout.leftMargin: 8
+            horizontalAlignment: Text.AlignRight
+            elide: Text.ElideRight
+        }
+    }
+
+    ListView {
+        id: list
+        anchors.fill: parent
+        model: paramModel
+        reuseItems: true
+        clip: true
+        boundsBehavior: Flickable.StopAtBounds
+        ScrollBar.vertical: ScrollBar {}
+        section.property: "tab"
+        section.delegate: Label {
+            text: section
+            font.bold: true
+            padding: 8
+        }
+
+        delegate: DelegateChooser {
+            role: "type"
+            DelegateChoice {
+                roleValue: "bool"
+                ParamRow {
+                    title: model.name
+                    Switch {
+                        checked: model.value
+                        onToggled: model.value = checked
+                    }
+                    Item { Layout.fillWidth: true }
+                }
+            }
+            DelegateChoice {
+                roleValue: "int"
+                ParamRow {
+                    title: model.name
+                    SpinBox {
+                        from: model.minimum
+                        to: model.maximum
+                        value: model.value
+                        editable: true
+                        Layout.fillWidth: true
+                        onValueModified: model.value = value
+                    }
+                }
+            }
+            DelegateChoice {
+                roleValue: "double"
+                ParamRow {
+                    title: model.name
+                    Slider {
+                        from: model.minimum
+                        to: model.maximum
+                        value: model.value
+                        Layout.fillWidth: true
+                        onMoved: model.value = value
+                    }
+                    TextField {
+                        text: model.text
+                        validator: DoubleValidator { bottom: model.minimum; top: model.maximum }
+                        Layout.preferredWidth: 110
+                        onEditingFinished: model.value = Number(text)
+                    }
+                    Label { text: model.unit; visible: text.length > 0; Layout.rightMargin: 8 }
+                }
+            }
+            DelegateChoice {
+                roleValue: "choice"
+                ParamRow {
+                    id: choiceRow
+                    title: model.name
+                    function select(i) { model.value = i }
+                    ComboBox {
+                        model: options
+                        currentIndex: value
+                        Layout.fillWidth: true
+                        onActivated: choiceRow.select(currentIndex)
+                    }
+                }
+            }
+            DelegateChoice {
+                roleValue: "color"
+                ParamRow {
+                    title: model.name
+                    Rectangle {
+                        color: model.value
+                        border.color: "gray"
+                        Layout.preferredWidth: 32
+                        Layout.preferredHeight: 24
+                    }
+                    TextField {
+                        text: model.text
+                        Layout.fillWidth: true
+                        onEditingFinished: model.value = text
+                    }
+                }
+            }
+            DelegateChoice {
+                roleValue: "range"
+                ParamRow {
+                    title: model.name
+                    TextField {
+                        id: low
+                        text: model.value[0]
+                        validator: DoubleValidator {}
+                        Layout.fillWidth: true
+                        onEditingFinished: model.value = [Number(low.text), Number(high.text)]
+                    }
+                    Label { text: "to" }
+                    TextField {
+                        id: high
+                        text: model.value[1]
+                        validator: DoubleValidator {}
+                        Layout.fillWidth: true
+                        onEditingFinished: model.value = [Number(low.text), Number(high.text)]
+                    }
+                }
+            }
+            DelegateChoice {
+                roleValue: "text"
+                ParamRow {
+                    title: model.name
+                    TextField {
+                        text: model.text
+                        Layout.fillWidth: true
+                        Layout.rightMargin: 8
+                        onEditingFinished: model.value = text
+                    }
+                }
+            }
+            DelegateChoice {
+                roleValue: "password"
+                ParamRow {
+                    title: model.name
+                    TextField {
+                        text: model.text
+                        echoMode: TextInput.Password
+                        Layout.fillWidth: true
+                        Layout.rightMargin: 8
+                        onEditingFinished: model.value = text
+                    }
+                }
+            }
+            DelegateChoice {
+                ParamRow {
+                    title: model.name
+                    Label {
+                        text: model.text
+                        elide: Text.ElideRight
+                        Layout.fillWidth: true
+                        Layout.rightMargin: 8
+                    }
+                }
+            }
+        }
+    }
+
+    footer: ToolBar {
+        RowLayout {
+            anchors.fill: parent
+            Label {
+                id: status
+                Layout.fillWidth: true
+                Layout.leftMargin: 8
+            }
+            Button {
+                text: "APPLY"
+                onClicked: status.text = paramModel.apply() ? "" : "Some values are not valid"
+            }
+        }
+    }
+}
+)QML";
+}
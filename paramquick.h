@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Manuele Turini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file paramquick.h
+ * @brief Optional Qt Quick front end for the parameters of a ParamsEditor.
+ * @author Manuele Turini
+ * @copyright (C) 2025 Manuele Turini. All Rights Reserved.
+ *
+ * Requires the Qt Quick, Qt QML and Qt Quick Controls 2 modules. The parameters
+ * remain owned by the ParamsEditor; the editor dialog does not need to be shown
+ * and, since its rows are built lazily, costs no widget layout when it is not.
+ */
+
+#ifndef PARAMQUICK_H
+#define PARAMQUICK_H
+
+#include "parameditor.h"
+#include <QAbstractListModel>
+#include <QQuickView>
+
+/**
+ * @class ParamListModel
+ * @brief List model exposing the parameters of a ParamsEditor to QML.
+ *
+ * One row per parameter, in tab order. Values read and written through the
+ * model are the widget values (ParamBase::value() / setValue()), so the Quick
+ * front end and the dialog edit the same state, and apply(), load() and save()
+ * keep the dialog's semantics.
+ */
+class ParamListModel : public QAbstractListModel {
+    Q_OBJECT
+
+    /**
+     * @struct Row
+     * @brief A parameter and the data that never changes for it.
+     */
+    struct Row {
+        ParamBase   * param; ///< The parameter.
+        int         tab; ///< Index of the parameter's tab.
+        QString     type; ///< Delegate type, see typeOf().
+    };
+
+    ParamsEditor    * editor; ///< Editor owning the parameters.
+    QVector<Row>    rows; ///< Parameters in tab order.
+
+public:
+    /**
+     * @brief Roles exposed to QML.
+     */
+    enum Roles {
+        NameRole = Qt::UserRole + 1, ///< Parameter name.
+        TypeRole, ///< Delegate type: bool, int, double, choice, color, range, text, password or other.
+        ValueRole, ///< Widget value, writable.
+        TextRole, ///< Widget value as text.
+        MinimumRole, ///< Lowest accepted value (numeric types).
+        MaximumRole, ///< Highest accepted value (numeric types).
+        OptionsRole, ///< Options of a choice.
+        UnitRole, ///< Canonical unit symbol, if the parameter has a dimension.
+        TipRole, ///< Tooltip text.
+        TabRole, ///< Title of the parameter's tab.
+        ValidRole ///< False if the value cannot be applied.
+    };
+
+    /**
+     * @brief Constructor for ParamListModel.
+     * @param e Editor whose parameters are exposed; parameters added later appear as well.
+     * @param parent Parent object (default: nullptr).
+     */
+    ParamListModel(ParamsEditor* e, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role) const override;
+
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    QHash<int, QByteArray> roleNames() const override;
+
+    /**
+     * @brief Apply all parameters (see ParamsEditor::applyAll()).
+     * @return False if some parameter is invalid.
+     */
+    Q_INVOKABLE bool apply();
+
+    /**
+     * @brief Reset one parameter to its default value.
+     * @param row Row of the parameter.
+     */
+    Q_INVOKABLE void reset(int row);
+
+    /**
+     * @brief Load parameter values from an XML file (see ParamsEditor::loadFromFile()).
+     * @param path File path or local file URL.
+     */
+    Q_INVOKABLE void load(const QString& path);
+
+    /**
+     * @brief Save parameter values to an XML file (see ParamsEditor::saveToFile()).
+     * @param path File path or local file URL.
+     */
+    Q_INVOKABLE void save(const QString& path);
+
+    /**
+     * @brief Map a parameter to its delegate type.
+     * @param param Parameter to classify.
+     * @return The value of TypeRole.
+     */
+    static QString typeOf(ParamBase* param);
+
+private slots:
+    void onParamAdded(int tab, ParamBase* param);
+
+private:
+    void track(int position, int tab, ParamBase* param);
+
+    int rowOf(const ParamBase* param) const;
+
+    void rowChanged(const ParamBase* param, const QVector<int>& roles);
+
+    static QVariant bound(ParamBase* param, bool upper);
+
+    static QString textOf(const QVariant& v);
+
+    static QString localPath(const QString& path);
+};
+
+/**
+ * @class ParamQuickView
+ * @brief Scene-graph view of the parameters of a ParamsEditor.
+ *
+ * Rows are drawn by a ListView that recycles its delegates (reuseItems) and
+ * picks them by parameter type through a DelegateChooser, so scrolling large
+ * editors only rebinds the few rows entering the viewport. The QML is embedded;
+ * the model is available to it as "paramModel".
+ */
+class ParamQuickView : public QQuickView {
+    Q_OBJECT
+    ParamListModel  * model; ///< Model shown by the view.
+
+public:
+    /**
+     * @brief Constructor for ParamQuickView.
+     * @param editor Editor whose parameters are shown.
+     * @param parent Parent window (default: nullptr).
+     */
+    ParamQuickView(ParamsEditor* editor, QWindow* parent = nullptr);
+
+    /**
+     * @brief Get the model shown by the view.
+     */
+    ParamListModel* paramModel() const { return model; }
+
+    /**
+     * @brief Select the software scene-graph renderer for devices without a usable GPU.
+     *
+     * Must be called before the first Qt Quick window is created.
+     */
+    static void useSoftwareRenderer();
+
+    /**
+     * @brief Get the embedded QML of the view.
+     */
+    static QByteArray qml();
+};
+
+#endif // PARAMQUICK_H
@@ -24,17 +24,19 @@ class ExtendedConfig : public QObject {
         Q_PROPERTY(QVariant variantValue READ variantValue WRITE setVariantValue NOTIFY variantValueChanged)
 
         // Propriet di metadati (costanti)
-        Q_PROPERTY(QString integerDisplay READ integerDisplay CONSTANT)
-        Q_PROPERTY(QString colorCategory READ colorCategory CONSTANT)
+        Q_CLASSINFO("integerValueDisplay", "Integer Setting")
+        Q_CLASSINFO("integerValueMin", "0")
+        Q_CLASSINFO("integerValueMax", "100")
+        Q_CLASSINFO("integerValueTooltip", "Integer setting between 0 and 100")
+        Q_CLASSINFO("doubleValueStep", "0.01")
+        Q_CLASSINFO("colorValueCategory", "Appearance")
 
 public:
     ExtendedConfig(QObject* parent = nullptr) : QObject(parent) {
         m_integerValue = 42;
-        m_integerDisplay = "Integer Setting";
         m_doubleValue = 3.14159;
         m_stringValue = "Default Text";
         m_colorValue = QColor(Qt::blue);
-        m_colorCategory = "Appearance";
         m_stringListValue = QStringList() << "Item1" << "Item2" << "Item3";
         m_dateValue = QDate::currentDate();
         m_timeValue = QTime::currentTime();
@@ -47,11 +49,9 @@ public:
 
     // Getter
     int integerValue() const { return m_integerValue; }
-    QString integerDisplay() const { return m_integerDisplay; }
     double doubleValue() const { return m_doubleValue; }
     QString stringValue() const { return m_stringValue; }
     QColor colorValue() const { return m_colorValue; }
-    QString colorCategory() const { return m_colorCategory; }
     QStringList stringListValue() const { return m_stringListValue; }
     QDate dateValue() const { return m_dateValue; }
     QTime timeValue() const { return m_timeValue; }
@@ -163,11 +163,9 @@ signals:
 
 private:
     int m_integerValue;
-    QString m_integerDisplay;
     double m_doubleValue;
     QString m_stringValue;
     QColor m_colorValue;
-    QString m_colorCategory;
     QStringList m_stringListValue;
     QDate m_dateValue;
     QTime m_timeValue;